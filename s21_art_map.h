@@ -0,0 +1,881 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Turns a key into bytes whose lexicographic order is the key order:
+// integers big-endian with the sign bit flipped, strings as they are.
+template <class Key, class = void>
+struct art_key_traits;
+
+template <class Key>
+struct art_key_traits<Key, std::enable_if_t<std::is_integral<Key>::value &&
+                                            !std::is_same<Key, bool>::value>> {
+  using bytes = std::array<unsigned char, sizeof(Key)>;
+
+  static bytes encode(Key key) {
+    using Unsigned = std::make_unsigned_t<Key>;
+    auto value = static_cast<Unsigned>(key);
+    if (std::is_signed<Key>::value) {
+      value ^= static_cast<Unsigned>(Unsigned(1) << (8 * sizeof(Key) - 1));
+    }
+    bytes out;
+    for (size_t i = sizeof(Key); i-- > 0; value >>= 8) {
+      out[i] = static_cast<unsigned char>(value);
+    }
+    return out;
+  }
+};
+
+template <>
+struct art_key_traits<std::string> {
+  using bytes = std::string_view;
+
+  static bytes encode(const std::string &key) { return key; }
+};
+
+// Adaptive radix tree: inner nodes grow from 4 to 16, 48 and 256 children
+// as they fill and shrink back as they empty. Chains of single-child nodes
+// are folded into a prefix on the node below, and a key that is a prefix of
+// other keys is stored on the inner node where it ends. Leaves are also
+// linked in key order, so iteration never walks the trie.
+template <class Key, class T,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class art_map {
+  using traits = art_key_traits<Key>;
+  using key_bytes = typename traits::bytes;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+
+ private:
+  struct Leaf {
+    value_type item;
+    Leaf *prev = nullptr;
+    Leaf *next = nullptr;
+
+    explicit Leaf(const value_type &value) : item(value) {}
+  };
+
+  // A child is a tagged pointer: leaves have the low bit set.
+  using Ref = uintptr_t;
+
+  enum NodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+  // Prefix bytes past maxPrefix are not stored; they are read from the
+  // smallest leaf below the node, which shares them.
+  static constexpr size_type maxPrefix = 8;
+
+  struct Inner {
+    NodeType type;
+    uint16_t count = 0;
+    uint32_t prefixLength = 0;
+    unsigned char prefix[maxPrefix] = {};
+    Leaf *leaf = nullptr;
+
+    explicit Inner(NodeType t) : type(t) {}
+  };
+
+  template <size_type Capacity, NodeType Type>
+  struct SortedNode : Inner {
+    static constexpr size_type capacity = Capacity;
+    unsigned char keys[Capacity] = {};
+    Ref children[Capacity] = {};
+
+    SortedNode() : Inner(Type) {}
+  };
+
+  using Node4 = SortedNode<4, NODE4>;
+  using Node16 = SortedNode<16, NODE16>;
+
+  struct Node48 : Inner {
+    // Slot of each byte's child plus one; 0 marks a missing child.
+    unsigned char index[256] = {};
+    Ref children[48] = {};
+
+    Node48() : Inner(NODE48) {}
+  };
+
+  struct Node256 : Inner {
+    Ref children[256] = {};
+
+    Node256() : Inner(NODE256) {}
+  };
+
+ public:
+  class ArtMapIterator {
+    friend art_map;
+
+   public:
+    ArtMapIterator(const art_map *m, Leaf *l) : map(m), leaf(l) {}
+
+    reference operator*() const { return leaf->item; }
+
+    ArtMapIterator &operator++() {
+      leaf = leaf->next;
+      return *this;
+    }
+
+    ArtMapIterator operator++(int) {
+      auto iter = *this;
+      ++(*this);
+      return iter;
+    }
+
+    ArtMapIterator &operator--() {
+      leaf = leaf ? leaf->prev : map->tail;
+      return *this;
+    }
+
+    ArtMapIterator operator--(int) {
+      auto iter = *this;
+      --(*this);
+      return iter;
+    }
+
+    bool operator!=(const ArtMapIterator &it) const noexcept {
+      return map != it.map || leaf != it.leaf;
+    }
+
+    bool operator==(const ArtMapIterator &it) const noexcept {
+      return map == it.map && leaf == it.leaf;
+    }
+
+   private:
+    const art_map *map;
+    Leaf *leaf;
+  };
+
+  using iterator = ArtMapIterator;
+  using const_iterator = ArtMapIterator;
+
+  art_map() {}
+  art_map(std::initializer_list<value_type> const &items) {
+    for (auto &item : items) {
+      insert(item);
+    }
+  }
+  art_map(const art_map &m) {
+    for (auto leaf = m.head; leaf; leaf = leaf->next) {
+      insert(leaf->item);
+    }
+  }
+  art_map(art_map &&m) noexcept { swap(m); }
+  ~art_map() { clear(); }
+  art_map &operator=(art_map &&m) {
+    if (this != &m) {
+      clear();
+      swap(m);
+    }
+    return *this;
+  }
+
+  T &at(const Key &key) {
+    auto leaf = findLeaf(key);
+    if (!leaf) {
+      throw std::out_of_range("out_of_range");
+    }
+    return leaf->item.second;
+  }
+
+  T &operator[](const Key &key) {
+    return insert(value_type{key, T()}).first.leaf->item.second;
+  }
+
+  iterator begin() { return iterator(this, head); }
+  iterator end() { return iterator(this, nullptr); }
+  const_iterator cbegin() const { return const_iterator(this, head); }
+  const_iterator cend() const { return const_iterator(this, nullptr); }
+
+  bool empty() const { return count == 0; }
+  size_type size() const { return count; }
+  size_type max_size() const { return std::numeric_limits<size_type>::max(); }
+
+  void clear() {
+    freeRef(root);
+    root = 0;
+    head = tail = nullptr;
+    count = 0;
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    auto bytes = traits::encode(value.first);
+    auto next = lowerBoundLeaf(root, bytes, 0);
+    if (next && compareKeys(leafKey(next), bytes) == 0) {
+      return {iterator(this, next), false};
+    }
+    auto leaf = create<Leaf>(value);
+    insertLeaf(leaf, bytes);
+    linkLeaf(leaf, next);
+    return {iterator(this, leaf), true};
+  }
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return insert(value_type{key, obj});
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    auto result = insert(value_type{key, obj});
+    if (!result.second) {
+      result.first.leaf->item.second = obj;
+    }
+    return result;
+  }
+
+  void erase(iterator pos) { eraseLeaf(pos.leaf); }
+
+  void swap(art_map &other) {
+    std::swap(root, other.root);
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    std::swap(count, other.count);
+    std::swap(allocator, other.allocator);
+  }
+
+  void merge(art_map &other) {
+    for (auto it = other.begin(); it != other.end();) {
+      auto pos = it++;
+      if (insert(*pos).second) {
+        other.erase(pos);
+      }
+    }
+  }
+
+  iterator find(const Key &key) { return iterator(this, findLeaf(key)); }
+  bool contains(const Key &key) { return findLeaf(key) != nullptr; }
+
+  iterator lower_bound(const Key &key) {
+    return iterator(this, lowerBoundLeaf(root, traits::encode(key), 0));
+  }
+
+  iterator upper_bound(const Key &key) {
+    auto bytes = traits::encode(key);
+    auto leaf = lowerBoundLeaf(root, bytes, 0);
+    if (leaf && compareKeys(leafKey(leaf), bytes) == 0) {
+      leaf = leaf->next;
+    }
+    return iterator(this, leaf);
+  }
+
+  template <class... Args>
+  s21::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
+    s21::vector<std::pair<iterator, bool>> out;
+    out.push_back(insert(value_type(std::forward<Args>(args)...)));
+    return out;
+  }
+
+ private:
+  static bool isLeaf(Ref ref) { return ref & 1; }
+  static Leaf *toLeaf(Ref ref) { return reinterpret_cast<Leaf *>(ref - 1); }
+  static Inner *toInner(Ref ref) { return reinterpret_cast<Inner *>(ref); }
+  static Ref fromLeaf(Leaf *leaf) { return reinterpret_cast<Ref>(leaf) + 1; }
+  static Ref fromInner(Inner *node) { return reinterpret_cast<Ref>(node); }
+
+  static unsigned char byteAt(const key_bytes &key, size_type i) {
+    return static_cast<unsigned char>(key[i]);
+  }
+
+  static key_bytes leafKey(const Leaf *leaf) {
+    return traits::encode(leaf->item.first);
+  }
+
+  static int compareKeys(const key_bytes &lhs, const key_bytes &rhs) {
+    auto size = std::min(lhs.size(), rhs.size());
+    int order = size ? std::memcmp(lhs.data(), rhs.data(), size) : 0;
+    if (order) return order;
+    return (lhs.size() > rhs.size()) - (lhs.size() < rhs.size());
+  }
+
+  template <class NodeType, class... Args>
+  NodeType *create(Args &&...args) {
+    using node_allocator = typename std::allocator_traits<
+        Allocator>::template rebind_alloc<NodeType>;
+    using node_traits = std::allocator_traits<node_allocator>;
+    node_allocator alloc(allocator);
+    auto node = node_traits::allocate(alloc, 1);
+    node_traits::construct(alloc, node, std::forward<Args>(args)...);
+    return node;
+  }
+
+  template <class NodeType>
+  void destroy(NodeType *node) {
+    using node_allocator = typename std::allocator_traits<
+        Allocator>::template rebind_alloc<NodeType>;
+    using node_traits = std::allocator_traits<node_allocator>;
+    node_allocator alloc(allocator);
+    node_traits::destroy(alloc, node);
+    node_traits::deallocate(alloc, node, 1);
+  }
+
+  void destroyInner(Inner *node) {
+    switch (node->type) {
+      case NODE4:
+        return destroy(static_cast<Node4 *>(node));
+      case NODE16:
+        return destroy(static_cast<Node16 *>(node));
+      case NODE48:
+        return destroy(static_cast<Node48 *>(node));
+      case NODE256:
+        return destroy(static_cast<Node256 *>(node));
+    }
+  }
+
+  template <class Visit>
+  static void forEachChild(Inner *node, Visit visit) {
+    switch (node->type) {
+      case NODE4:
+        for (size_type i = 0; i < node->count; i++) {
+          visit(static_cast<Node4 *>(node)->keys[i],
+                static_cast<Node4 *>(node)->children[i]);
+        }
+        break;
+      case NODE16:
+        for (size_type i = 0; i < node->count; i++) {
+          visit(static_cast<Node16 *>(node)->keys[i],
+                static_cast<Node16 *>(node)->children[i]);
+        }
+        break;
+      case NODE48: {
+        auto n = static_cast<Node48 *>(node);
+        for (size_type b = 0; b < 256; b++) {
+          if (n->index[b]) visit(b, n->children[n->index[b] - 1]);
+        }
+        break;
+      }
+      case NODE256: {
+        auto n = static_cast<Node256 *>(node);
+        for (size_type b = 0; b < 256; b++) {
+          if (n->children[b]) visit(b, n->children[b]);
+        }
+        break;
+      }
+    }
+  }
+
+  void freeRef(Ref ref) {
+    if (!ref) {
+      return;
+    }
+    if (isLeaf(ref)) {
+      destroy(toLeaf(ref));
+      return;
+    }
+    auto node = toInner(ref);
+    forEachChild(node, [&](size_type, Ref child) { freeRef(child); });
+    if (node->leaf) destroy(node->leaf);
+    destroyInner(node);
+  }
+
+  // Bit i of the result is set when keys[i] equals b.
+  static int matchMask(const Node16 *node, unsigned char b) {
+#if defined(__SSE2__)
+    auto keys = _mm_loadu_si128(reinterpret_cast<const __m128i *>(node->keys));
+    auto equal = _mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(b)));
+    return _mm_movemask_epi8(equal) & ((1 << node->count) - 1);
+#else
+    int mask = 0;
+    for (size_type i = 0; i < node->count; i++) {
+      if (node->keys[i] == b) mask |= 1 << i;
+    }
+    return mask;
+#endif
+  }
+
+  // Number of keys below b; SSE2 only compares signed bytes, so both sides
+  // get their top bit flipped first.
+  static size_type rank(const Node16 *node, unsigned char b) {
+#if defined(__SSE2__)
+    auto flip = _mm_set1_epi8(static_cast<char>(0x80));
+    auto keys = _mm_xor_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(node->keys)), flip);
+    auto probe = _mm_xor_si128(_mm_set1_epi8(static_cast<char>(b)), flip);
+    auto less = _mm_movemask_epi8(_mm_cmplt_epi8(keys, probe));
+    return __builtin_popcount(less & ((1 << node->count) - 1));
+#else
+    size_type i = 0;
+    while (i < node->count && node->keys[i] < b) i++;
+    return i;
+#endif
+  }
+
+  static size_type rank(const Node4 *node, unsigned char b) {
+    size_type i = 0;
+    while (i < node->count && node->keys[i] < b) i++;
+    return i;
+  }
+
+  static Ref *findChild(Inner *node, unsigned char b) {
+    switch (node->type) {
+      case NODE4: {
+        auto n = static_cast<Node4 *>(node);
+        for (size_type i = 0; i < n->count; i++) {
+          if (n->keys[i] == b) return &n->children[i];
+        }
+        return nullptr;
+      }
+      case NODE16: {
+        auto n = static_cast<Node16 *>(node);
+        auto mask = matchMask(n, b);
+        return mask ? &n->children[__builtin_ctz(mask)] : nullptr;
+      }
+      case NODE48: {
+        auto n = static_cast<Node48 *>(node);
+        return n->index[b] ? &n->children[n->index[b] - 1] : nullptr;
+      }
+      case NODE256: {
+        auto n = static_cast<Node256 *>(node);
+        return n->children[b] ? &n->children[b] : nullptr;
+      }
+    }
+    return nullptr;
+  }
+
+  // The child with the smallest byte above b, or 0.
+  template <class Sorted>
+  static Ref nextSorted(Sorted *node, unsigned char b) {
+    auto i = b == 255 ? node->count : rank(node, b + 1);
+    return i < node->count ? node->children[i] : 0;
+  }
+
+  static Ref nextChild(Inner *node, size_type b) {
+    switch (node->type) {
+      case NODE4:
+        return b > 255 ? static_cast<Node4 *>(node)->children[0]
+                       : nextSorted(static_cast<Node4 *>(node), b);
+      case NODE16:
+        return b > 255 ? static_cast<Node16 *>(node)->children[0]
+                       : nextSorted(static_cast<Node16 *>(node), b);
+      case NODE48: {
+        auto n = static_cast<Node48 *>(node);
+        for (b = b > 255 ? 0 : b + 1; b < 256; b++) {
+          if (n->index[b]) return n->children[n->index[b] - 1];
+        }
+        return 0;
+      }
+      case NODE256: {
+        auto n = static_cast<Node256 *>(node);
+        for (b = b > 255 ? 0 : b + 1; b < 256; b++) {
+          if (n->children[b]) return n->children[b];
+        }
+        return 0;
+      }
+    }
+    return 0;
+  }
+
+  static constexpr size_type beforeFirst = 256;
+
+  static Leaf *minimum(Ref ref) {
+    while (!isLeaf(ref)) {
+      auto node = toInner(ref);
+      if (node->leaf) return node->leaf;
+      ref = nextChild(node, beforeFirst);
+    }
+    return toLeaf(ref);
+  }
+
+  static unsigned char prefixByte(Inner *node, size_type depth, size_type i) {
+    return i < maxPrefix ? node->prefix[i]
+                         : byteAt(leafKey(minimum(fromInner(node))), depth + i);
+  }
+
+  // Index of the first prefix byte of node that differs from key, or at
+  // which key runs out; prefixLength when the whole prefix matches.
+  static size_type prefixMismatch(Inner *node, const key_bytes &key,
+                                  size_type depth) {
+    size_type length = node->prefixLength;
+    for (size_type i = 0; i < length; i++) {
+      if (depth + i >= key.size() ||
+          prefixByte(node, depth, i) != byteAt(key, depth + i)) {
+        return i;
+      }
+    }
+    return length;
+  }
+
+  static void setPrefix(Inner *node, const key_bytes &key, size_type depth,
+                        size_type length) {
+    node->prefixLength = static_cast<uint32_t>(length);
+    for (size_type i = 0; i < length && i < maxPrefix; i++) {
+      node->prefix[i] = byteAt(key, depth + i);
+    }
+  }
+
+  Leaf *findLeaf(const Key &key) const {
+    auto bytes = traits::encode(key);
+    Ref ref = root;
+    for (size_type depth = 0; ref; depth++) {
+      if (isLeaf(ref)) {
+        auto leaf = toLeaf(ref);
+        return compareKeys(leafKey(leaf), bytes) == 0 ? leaf : nullptr;
+      }
+      auto node = toInner(ref);
+      if (node->prefixLength) {
+        if (prefixMismatch(node, bytes, depth) != node->prefixLength) {
+          return nullptr;
+        }
+        depth += node->prefixLength;
+      }
+      if (depth == bytes.size()) {
+        return node->leaf;
+      }
+      auto child = findChild(node, byteAt(bytes, depth));
+      ref = child ? *child : 0;
+    }
+    return nullptr;
+  }
+
+  // The smallest leaf under ref whose key is not below key, or nullptr.
+  static Leaf *lowerBoundLeaf(Ref ref, const key_bytes &key, size_type depth) {
+    if (!ref) {
+      return nullptr;
+    }
+    if (isLeaf(ref)) {
+      auto leaf = toLeaf(ref);
+      return compareKeys(leafKey(leaf), key) >= 0 ? leaf : nullptr;
+    }
+    auto node = toInner(ref);
+    auto mismatch = prefixMismatch(node, key, depth);
+    if (mismatch < node->prefixLength) {
+      bool greater = depth + mismatch == key.size() ||
+                     prefixByte(node, depth, mismatch) >
+                         byteAt(key, depth + mismatch);
+      return greater ? minimum(ref) : nullptr;
+    }
+    depth += node->prefixLength;
+    if (depth == key.size()) {
+      return minimum(ref);
+    }
+    auto b = byteAt(key, depth);
+    if (auto child = findChild(node, b)) {
+      if (auto leaf = lowerBoundLeaf(*child, key, depth + 1)) return leaf;
+    }
+    auto next = nextChild(node, b);
+    return next ? minimum(next) : nullptr;
+  }
+
+  template <class From, class To>
+  static void copyHeader(From *from, To *to) {
+    to->count = from->count;
+    to->prefixLength = from->prefixLength;
+    std::memcpy(to->prefix, from->prefix, maxPrefix);
+    to->leaf = from->leaf;
+  }
+
+  Inner *grow(Ref &ref, Inner *node) {
+    Inner *bigger = nullptr;
+    switch (node->type) {
+      case NODE4: {
+        auto from = static_cast<Node4 *>(node);
+        auto to = create<Node16>();
+        copyHeader(from, to);
+        std::copy(from->keys, from->keys + from->count, to->keys);
+        std::copy(from->children, from->children + from->count, to->children);
+        destroy(from);
+        bigger = to;
+        break;
+      }
+      case NODE16: {
+        auto from = static_cast<Node16 *>(node);
+        auto to = create<Node48>();
+        copyHeader(from, to);
+        for (size_type i = 0; i < from->count; i++) {
+          to->index[from->keys[i]] = static_cast<unsigned char>(i + 1);
+          to->children[i] = from->children[i];
+        }
+        destroy(from);
+        bigger = to;
+        break;
+      }
+      default: {
+        auto from = static_cast<Node48 *>(node);
+        auto to = create<Node256>();
+        copyHeader(from, to);
+        for (size_type b = 0; b < 256; b++) {
+          if (from->index[b]) {
+            to->children[b] = from->children[from->index[b] - 1];
+          }
+        }
+        destroy(from);
+        bigger = to;
+      }
+    }
+    ref = fromInner(bigger);
+    return bigger;
+  }
+
+  template <class Sorted>
+  static bool addSorted(Sorted *node, unsigned char b, Ref child) {
+    if (node->count == Sorted::capacity) {
+      return false;
+    }
+    auto i = rank(node, b);
+    std::copy_backward(node->keys + i, node->keys + node->count,
+                       node->keys + node->count + 1);
+    std::copy_backward(node->children + i, node->children + node->count,
+                       node->children + node->count + 1);
+    node->keys[i] = b;
+    node->children[i] = child;
+    node->count++;
+    return true;
+  }
+
+  void addChild(Ref &ref, Inner *node, unsigned char b, Ref child) {
+    switch (node->type) {
+      case NODE4:
+        if (addSorted(static_cast<Node4 *>(node), b, child)) return;
+        break;
+      case NODE16:
+        if (addSorted(static_cast<Node16 *>(node), b, child)) return;
+        break;
+      case NODE48: {
+        auto n = static_cast<Node48 *>(node);
+        if (n->count == 48) break;
+        size_type slot = 0;
+        while (n->children[slot]) slot++;
+        n->children[slot] = child;
+        n->index[b] = static_cast<unsigned char>(slot + 1);
+        n->count++;
+        return;
+      }
+      case NODE256:
+        static_cast<Node256 *>(node)->children[b] = child;
+        node->count++;
+        return;
+    }
+    addChild(ref, grow(ref, node), b, child);
+  }
+
+  // Hangs leaf on a fresh Node4 whose prefix ends at depth.
+  void placeLeaf(Node4 *node, Leaf *leaf, const key_bytes &key,
+                 size_type depth) {
+    if (depth == key.size()) {
+      node->leaf = leaf;
+    } else {
+      addSorted(node, byteAt(key, depth), fromLeaf(leaf));
+    }
+  }
+
+  void insertLeaf(Leaf *leaf, const key_bytes &key) {
+    Ref *ref = &root;
+    for (size_type depth = 0;; depth++) {
+      if (!*ref) {
+        *ref = fromLeaf(leaf);
+        return;
+      }
+      if (isLeaf(*ref)) {
+        auto other = toLeaf(*ref);
+        auto otherKey = leafKey(other);
+        size_type common = 0, end = std::min(key.size(), otherKey.size());
+        for (; depth + common < end; common++) {
+          auto i = depth + common;
+          if (byteAt(key, i) != byteAt(otherKey, i)) break;
+        }
+        auto node = create<Node4>();
+        setPrefix(node, key, depth, common);
+        placeLeaf(node, other, otherKey, depth + common);
+        placeLeaf(node, leaf, key, depth + common);
+        *ref = fromInner(node);
+        return;
+      }
+      auto node = toInner(*ref);
+      auto mismatch = prefixMismatch(node, key, depth);
+      if (mismatch < node->prefixLength) {
+        auto parent = create<Node4>();
+        setPrefix(parent, key, depth, mismatch);
+        auto split = prefixByte(node, depth, mismatch);
+        unsigned char rest[maxPrefix];
+        for (size_type i = 0; i < maxPrefix; i++) {
+          if (mismatch + 1 + i < node->prefixLength) {
+            rest[i] = prefixByte(node, depth, mismatch + 1 + i);
+          }
+        }
+        node->prefixLength -= static_cast<uint32_t>(mismatch + 1);
+        std::memcpy(node->prefix, rest, maxPrefix);
+        addSorted(parent, split, fromInner(node));
+        placeLeaf(parent, leaf, key, depth + mismatch);
+        *ref = fromInner(parent);
+        return;
+      }
+      depth += node->prefixLength;
+      if (depth == key.size()) {
+        node->leaf = leaf;
+        return;
+      }
+      auto child = findChild(node, byteAt(key, depth));
+      if (!child) {
+        addChild(*ref, node, byteAt(key, depth), fromLeaf(leaf));
+        return;
+      }
+      ref = child;
+    }
+  }
+
+  void linkLeaf(Leaf *leaf, Leaf *next) {
+    leaf->next = next;
+    leaf->prev = next ? next->prev : tail;
+    (leaf->prev ? leaf->prev->next : head) = leaf;
+    (next ? next->prev : tail) = leaf;
+    count++;
+  }
+
+  template <class Sorted>
+  static void removeSorted(Sorted *node, unsigned char b) {
+    size_type i = 0;
+    while (node->keys[i] != b) i++;
+    std::copy(node->keys + i + 1, node->keys + node->count, node->keys + i);
+    std::copy(node->children + i + 1, node->children + node->count,
+              node->children + i);
+    node->count--;
+  }
+
+  void removeChild(Inner *node, unsigned char b) {
+    switch (node->type) {
+      case NODE4:
+        return removeSorted(static_cast<Node4 *>(node), b);
+      case NODE16:
+        return removeSorted(static_cast<Node16 *>(node), b);
+      case NODE48: {
+        auto n = static_cast<Node48 *>(node);
+        n->children[n->index[b] - 1] = 0;
+        n->index[b] = 0;
+        n->count--;
+        return;
+      }
+      case NODE256:
+        static_cast<Node256 *>(node)->children[b] = 0;
+        node->count--;
+        return;
+    }
+  }
+
+  // Moves the children of an underfull node into the next smaller type.
+  Inner *shrink(Ref &ref, Inner *node) {
+    Inner *smaller = node;
+    if (node->type == NODE256 && node->count <= 36) {
+      auto from = static_cast<Node256 *>(node);
+      auto to = create<Node48>();
+      copyHeader(from, to);
+      size_type slot = 0;
+      for (size_type b = 0; b < 256; b++) {
+        if (from->children[b]) {
+          to->children[slot] = from->children[b];
+          to->index[b] = static_cast<unsigned char>(++slot);
+        }
+      }
+      destroy(from);
+      smaller = to;
+    } else if (node->type == NODE48 && node->count <= 12) {
+      auto from = static_cast<Node48 *>(node);
+      auto to = create<Node16>();
+      copyHeader(from, to);
+      size_type i = 0;
+      for (size_type b = 0; b < 256; b++) {
+        if (from->index[b]) {
+          to->keys[i] = static_cast<unsigned char>(b);
+          to->children[i++] = from->children[from->index[b] - 1];
+        }
+      }
+      destroy(from);
+      smaller = to;
+    } else if (node->type == NODE16 && node->count <= 3) {
+      auto from = static_cast<Node16 *>(node);
+      auto to = create<Node4>();
+      copyHeader(from, to);
+      std::copy(from->keys, from->keys + from->count, to->keys);
+      std::copy(from->children, from->children + from->count, to->children);
+      destroy(from);
+      smaller = to;
+    }
+    ref = fromInner(smaller);
+    return smaller;
+  }
+
+  // After a removal, a node left with only its own key becomes that leaf,
+  // and one left with a single child is folded into the child's prefix.
+  void collapse(Ref &ref, Inner *node) {
+    node = shrink(ref, node);
+    if (node->count == 0 && node->leaf) {
+      ref = fromLeaf(node->leaf);
+      destroyInner(node);
+    } else if (node->count == 1 && !node->leaf) {
+      auto n = static_cast<Node4 *>(node);
+      auto child = n->children[0];
+      if (!isLeaf(child)) {
+        auto inner = toInner(child);
+        unsigned char prefix[maxPrefix];
+        size_type length = n->prefixLength + 1 + inner->prefixLength;
+        for (size_type i = 0; i < maxPrefix && i < length; i++) {
+          if (i < n->prefixLength) {
+            prefix[i] = n->prefix[i];
+          } else if (i == n->prefixLength) {
+            prefix[i] = n->keys[0];
+          } else {
+            prefix[i] = inner->prefix[i - n->prefixLength - 1];
+          }
+        }
+        std::memcpy(inner->prefix, prefix, std::min(length, maxPrefix));
+        inner->prefixLength = static_cast<uint32_t>(length);
+      }
+      ref = child;
+      destroy(n);
+    }
+  }
+
+  void eraseLeaf(Leaf *leaf) {
+    auto key = leafKey(leaf);
+    Ref *ref = &root;
+    for (size_type depth = 0;; depth++) {
+      if (isLeaf(*ref)) {
+        *ref = 0;
+        break;
+      }
+      auto node = toInner(*ref);
+      depth += node->prefixLength;
+      if (depth == key.size()) {
+        node->leaf = nullptr;
+        collapse(*ref, node);
+        break;
+      }
+      auto b = byteAt(key, depth);
+      auto child = findChild(node, b);
+      if (isLeaf(*child)) {
+        removeChild(node, b);
+        collapse(*ref, node);
+        break;
+      }
+      ref = child;
+    }
+    (leaf->prev ? leaf->prev->next : head) = leaf->next;
+    (leaf->next ? leaf->next->prev : tail) = leaf->prev;
+    destroy(leaf);
+    count--;
+  }
+
+  Ref root = 0;
+  Leaf *head = nullptr;
+  Leaf *tail = nullptr;
+  size_type count = 0;
+  Allocator allocator;
+};
+
+};  // namespace s21
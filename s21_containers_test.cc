@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <deque>
 #include <list>
 #include <map>
 #include <queue>
@@ -985,6 +986,239 @@ TEST(Map, emplace) {
   EXPECT_EQ(s21_map.size(), 2);
 }
 
+TEST(Map, find_batch) {
+  s21::map<int, std::string> s21_map;
+  for (int i = 0; i < 1000; i += 3) {
+    s21_map.insert(i, std::to_string(i));
+  }
+
+  std::vector<int> keys;
+  for (int i = 999; i >= -20; i -= 2) keys.push_back(i);
+  std::vector<decltype(s21_map.begin())> found;
+  s21_map.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+
+  ASSERT_EQ(found.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    EXPECT_TRUE(found[i] == s21_map.find(keys[i]));
+    if (found[i] != s21_map.end()) {
+      EXPECT_EQ((*found[i]).second, std::to_string(keys[i]));
+    }
+  }
+}
+
+TEST(Map, finger_search) {
+  s21::map<int, int> s21_map;
+  std::map<int, int> std_map;
+  s21_map.set_finger_search(true);
+  for (int i = 0; i < 2000; i++) {
+    s21_map.insert(i * 5 % 2003, i);
+    std_map.insert({i * 5 % 2003, i});
+  }
+
+  for (int i = -3; i < 2010; i++) {
+    EXPECT_EQ(s21_map.contains(i), std_map.count(i) == 1);
+    if (i % 3 == 0 && std_map.count(i)) {
+      s21_map.erase(s21_map.find(i));
+      std_map.erase(i);
+      EXPECT_FALSE(s21_map.contains(i));
+    }
+  }
+  for (int i = 2010; i > -3; i -= 7) {
+    EXPECT_EQ(s21_map.contains(i), std_map.count(i) == 1);
+    if (std_map.count(i)) {
+      EXPECT_EQ(s21_map.at(i), std_map.at(i));
+    }
+  }
+  EXPECT_EQ(s21_map.size(), std_map.size());
+
+  s21_map.clear();
+  EXPECT_FALSE(s21_map.contains(5));
+  s21_map[5] = 1;
+  EXPECT_EQ(s21_map.at(5), 1);
+}
+
+TEST(Map, small_size) {
+  s21::small_map<int, std::string> s21_map = {{3, "c"}, {1, "a"}, {2, "b"}};
+  s21::small_map<int, std::string> other = {{10, "x"}};
+
+  EXPECT_EQ((*s21_map.begin()).second, "a");
+  s21_map[0] = "zero";
+  s21_map.insert_or_assign(2, "B");
+  EXPECT_EQ(s21_map.at(2), "B");
+
+  int probes[] = {0, 5, 3};
+  decltype(s21_map.begin()) found[3] = {s21_map.end(), s21_map.end(),
+                                        s21_map.end()};
+  s21_map.find_batch(probes, probes + 3, found);
+  EXPECT_EQ((*found[0]).second, "zero");
+  EXPECT_TRUE(found[1] == s21_map.end());
+  EXPECT_EQ((*found[2]).second, "c");
+
+  for (int i = 4; i < 20; i++) s21_map.insert(i, std::to_string(i));
+  EXPECT_EQ(s21_map.size(), 20);
+  int key = 0;
+  for (auto it = s21_map.begin(); it != s21_map.end(); it++) {
+    EXPECT_EQ((*it).first, key++);
+  }
+
+  s21_map.swap(other);
+  EXPECT_EQ(s21_map.size(), 1);
+  EXPECT_EQ(other.size(), 20);
+  other.merge(s21_map);
+  EXPECT_EQ(other.at(10), "10");
+  EXPECT_EQ(s21_map.at(10), "x");
+  other.clear();
+  other[7] = "seven";
+  EXPECT_EQ((*other.begin()).second, "seven");
+}
+
+TEST(Map, compact) {
+  s21::map<int, std::string> s21_map;
+  std::map<int, std::string> std_map;
+  for (int i = 0; i < 3000; i++) {
+    int key = i * 17 % 1009;
+    if (i % 3 == 2 && s21_map.contains(key)) {
+      s21_map.erase(s21_map.find(key));
+      std_map.erase(key);
+    } else {
+      s21_map.insert(key, std::string(40, 'a' + key % 26));
+      std_map.insert({key, std::string(40, 'a' + key % 26)});
+    }
+  }
+
+  for (int round = 0; round < 2; round++) {
+    s21_map.compact();
+    EXPECT_EQ(s21_map.size(), std_map.size());
+    auto stdIt = std_map.begin();
+    auto it = s21_map.begin();
+    auto prev = &*it;
+    std::ptrdiff_t stride = 0;
+    for (it++, stdIt++; it != s21_map.end(); it++, stdIt++) {
+      auto diff =
+          reinterpret_cast<char *>(&*it) - reinterpret_cast<char *>(prev);
+      if (!stride) stride = diff;
+      EXPECT_EQ(diff, stride);
+      EXPECT_EQ((*it).first, stdIt->first);
+      EXPECT_EQ((*it).second, stdIt->second);
+      prev = &*it;
+    }
+
+    for (int key = 0; key < 1009; key += 5) {
+      if (s21_map.contains(key)) {
+        s21_map.erase(s21_map.find(key));
+        std_map.erase(key);
+      }
+      s21_map.insert(key + 2000, "new");
+      std_map.insert({key + 2000, "new"});
+    }
+  }
+  EXPECT_EQ(s21_map.size(), std_map.size());
+  s21_map.clear();
+  s21_map.compact();
+  EXPECT_TRUE(s21_map.empty());
+}
+
+TEST(Map, parallel) {
+  s21::map<int, long long> s21_map;
+  long long expected = 0;
+  for (int i = 0; i < 50000; i++) {
+    s21_map.insert(i * 7919 % 50021, i);
+    expected += i;
+  }
+
+  s21_map.parallel_for_each(
+      [](std::pair<int, long long> &item) { item.second *= 2; });
+  auto sum = s21_map.parallel_reduce(
+      0LL, [](long long acc, const std::pair<int, long long> &item) {
+        return acc + item.second;
+      },
+      std::plus<long long>());
+  EXPECT_EQ(sum, expected * 2);
+
+  auto digits = [](std::string acc, const std::pair<int, long long> &item) {
+    return item.first < 5 ? acc + std::to_string(item.first) : acc;
+  };
+  auto keys = s21_map.parallel_reduce(
+      std::string(), digits,
+      [](std::string lhs, const std::string &rhs) { return lhs + rhs; });
+  EXPECT_EQ(keys, "01234");
+}
+
+TEST(Map, split_join) {
+  s21::map<int, std::string> s21_map;
+  for (int i = 0; i < 1000; i++) s21_map.insert(i, std::to_string(i));
+
+  auto upper = s21_map.split(600);
+  EXPECT_EQ(s21_map.size(), 600);
+  EXPECT_EQ(upper.size(), 400);
+  EXPECT_EQ((*upper.begin()).first, 600);
+  EXPECT_EQ(upper.at(999), "999");
+  EXPECT_FALSE(s21_map.contains(600));
+
+  upper.insert(1500, "x");
+  upper.join(s21_map);
+  EXPECT_EQ(upper.size(), 1001);
+  int key = 0;
+  for (auto it = upper.begin(); key < 1000; it++, key++) {
+    EXPECT_EQ((*it).second, std::to_string(key));
+  }
+}
+
+TEST(Map, lazy_erase) {
+  s21::map<int, int> s21_map;
+  s21_map.set_lazy_erase(0.5);
+  for (int i = 0; i < 1000; i++) s21_map.insert(i, i * i);
+  for (int i = 0; i < 1000; i += 2) s21_map.erase(s21_map.find(i));
+  EXPECT_EQ(s21_map.size(), 500);
+  EXPECT_FALSE(s21_map.contains(10));
+  EXPECT_EQ(s21_map.at(11), 121);
+  s21_map[10] = 7;
+  EXPECT_EQ(s21_map.at(10), 7);
+  EXPECT_EQ(s21_map.size(), 501);
+  int keys[] = {9, 10, 12};
+  s21::vector<decltype(s21_map.begin())> found;
+  s21_map.find_batch(keys, keys + 3, std::back_inserter(found));
+  EXPECT_EQ((*found[0]).second, 81);
+  EXPECT_EQ((*found[1]).second, 7);
+  EXPECT_TRUE(found[2] == s21_map.end());
+  s21_map.compact();
+  EXPECT_EQ(s21_map.size(), 501);
+  EXPECT_EQ(s21_map.at(999), 998001);
+}
+
+TEST(Map, string_keys) {
+  static_assert(sizeof(Node<std::pair<std::string, int>, std::less<>>) >
+                sizeof(Node<std::pair<int, int>, std::less<>>));
+  s21::map<std::string, int> s21_map;
+  std::map<std::string, int> std_map;
+  std::string prefixes[] = {"", "http://", "http://example.com/",
+                            std::string("a\0b", 3), "\xff\xfe"};
+  for (int i = 0; i < 2000; i++) {
+    auto key = prefixes[i % 5] + std::to_string(i * 7919 % 1000);
+    if (i % 3 == 0) key += std::string(1, '\0');
+    s21_map.insert(key, i);
+    std_map.insert({key, i});
+    if (i % 4 == 0) {
+      auto erased = prefixes[(i + 2) % 5] + std::to_string(i % 1000);
+      auto it = s21_map.find(erased);
+      if (it != s21_map.end()) s21_map.erase(it);
+      std_map.erase(erased);
+    }
+  }
+
+  EXPECT_EQ(s21_map.size(), std_map.size());
+  auto std_it = std_map.begin();
+  for (auto it = s21_map.begin(); it != s21_map.end(); it++, std_it++) {
+    EXPECT_EQ((*it).first, std_it->first);
+    EXPECT_EQ((*it).second, std_it->second);
+  }
+  for (auto &item : std_map) {
+    EXPECT_EQ(s21_map.at(item.first), item.second);
+  }
+  EXPECT_FALSE(s21_map.contains("http://example.com"));
+  EXPECT_FALSE(s21_map.contains(std::string("a\0", 2)));
+}
+
 // Set tests
 
 TEST(Set, constructor_0) {
@@ -1129,6 +1363,286 @@ TEST(Set, emplace) {
   EXPECT_EQ(s21_set.size(), 2);
 }
 
+TEST(Set, contains_batch) {
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 500; i++) {
+    s21_set.insert(i * 7 % 613);
+    std_set.insert(i * 7 % 613);
+  }
+
+  std::vector<int> keys;
+  for (int i = -5; i < 700; i++) keys.push_back(i);
+  std::vector<bool> found;
+  s21_set.contains_batch(keys.begin(), keys.end(), std::back_inserter(found));
+
+  ASSERT_EQ(found.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    EXPECT_EQ(found[i], std_set.count(keys[i]) == 1);
+  }
+
+  s21::set<int> empty;
+  bool out[2] = {true, true};
+  empty.contains_batch(keys.begin(), keys.begin() + 2, out);
+  EXPECT_FALSE(out[0] || out[1]);
+}
+
+TEST(Set, small_size) {
+  s21::small_set<std::string, 4> s21_set;
+  std::set<std::string> std_set;
+  const char *words[] = {"delta", "alpha", "echo",    "bravo", "alpha",
+                         "kilo",  "golf",  "charlie", "hotel", "india"};
+
+  for (auto word : words) {
+    EXPECT_EQ(s21_set.insert(word).second, std_set.insert(word).second);
+    EXPECT_EQ(s21_set.size(), std_set.size());
+    auto stdIt = std_set.begin();
+    for (auto it = s21_set.begin(); it != s21_set.end(); it++, stdIt++) {
+      EXPECT_EQ(*it, *stdIt);
+    }
+    EXPECT_TRUE(s21_set.contains(word));
+  }
+
+  for (auto word : words) {
+    if (s21_set.contains(word)) s21_set.erase(s21_set.find(word));
+    EXPECT_FALSE(s21_set.contains(word));
+  }
+  EXPECT_TRUE(s21_set.empty());
+
+  s21_set.insert("zulu");
+  s21_set.insert("yankee");
+  s21::small_set<std::string, 4> moved(std::move(s21_set));
+  EXPECT_EQ(s21_set.size(), 0);
+  EXPECT_EQ(*moved.begin(), "yankee");
+  EXPECT_EQ(*(++moved.begin()), "zulu");
+  EXPECT_TRUE(++(++moved.begin()) == moved.end());
+
+  s21::small_set<int, 4> stable = {5, 9};
+  auto five = stable.find(5);
+  stable.insert(1);
+  stable.erase(stable.find(9));
+  stable.insert(7);
+  stable.insert(3);
+  EXPECT_EQ(*five, 5);
+  EXPECT_EQ(*++five, 7);
+  int expected[] = {1, 3, 5, 7};
+  auto it = stable.begin();
+  for (int item : expected) EXPECT_EQ(*it++, item);
+  EXPECT_TRUE(it == stable.end());
+}
+
+TEST(Set, parallel) {
+  s21::set<int> s21_set;
+  for (int i = 1; i <= 10000; i++) s21_set.insert(i);
+
+  std::atomic<long long> sum{0};
+  s21_set.parallel_for_each([&](int item) { sum += item; });
+  EXPECT_EQ(sum, 50005000);
+  EXPECT_EQ(s21_set.parallel_reduce(0LL, std::plus<long long>()), 50005000);
+  EXPECT_EQ(s21_set.parallel_reduce(1000LL, std::plus<long long>()),
+            50006000);
+  EXPECT_EQ(s21_set.parallel_reduce(
+                std::string("<"),
+                [](std::string acc, int item) {
+                  return item <= 3 ? acc + std::to_string(item) : acc;
+                },
+                std::plus<std::string>()),
+            "<123");
+
+  s21::small_set<int> small = {3, 1, 2};
+  EXPECT_EQ(small.parallel_reduce(0, std::plus<int>()), 6);
+  s21::set<int> empty;
+  EXPECT_EQ(empty.parallel_reduce(7, std::plus<int>()), 7);
+
+  std::atomic<long long> nested{0};
+  s21_set.parallel_for_each([&](int item) {
+    if (item % 1000 == 0) {
+      nested += small.parallel_reduce(0, std::plus<int>()) +
+                s21_set.parallel_reduce(0LL, std::plus<long long>());
+    }
+  });
+  EXPECT_EQ(nested, 10 * (6 + 50005000LL));
+  EXPECT_THROW(s21_set.parallel_for_each([](int item) {
+    if (item == 5000) throw std::runtime_error("task");
+  }),
+               std::runtime_error);
+}
+
+TEST(Set, split_join) {
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 5000; i++) {
+    s21_set.insert(i * 37 % 5003);
+    std_set.insert(i * 37 % 5003);
+  }
+
+  for (int key : {2500, -1, 6000, 0, 4999, 1234}) {
+    auto rest = s21_set.split(key);
+    EXPECT_EQ(s21_set.size(), std::distance(std_set.begin(),
+                                            std_set.lower_bound(key)));
+    EXPECT_EQ(rest.size(), std::distance(std_set.lower_bound(key),
+                                         std_set.end()));
+    for (auto it = rest.begin(); it != rest.end(); it++) {
+      EXPECT_TRUE(*it >= key);
+    }
+    rest.insert(key);
+    rest.erase(rest.find(key));
+    if (std_set.count(key)) rest.insert(key);
+
+    if (key % 2) {
+      s21_set.join(rest);
+    } else {
+      rest.join(s21_set);
+      s21_set.swap(rest);
+    }
+    EXPECT_TRUE(rest.empty());
+    EXPECT_EQ(s21_set.size(), std_set.size());
+    auto std_it = std_set.begin();
+    for (auto it = s21_set.begin(); it != s21_set.end(); it++, std_it++) {
+      EXPECT_EQ(*it, *std_it);
+    }
+  }
+
+  s21::set<int> other = {100, 200};
+  EXPECT_THROW(s21_set.join(other), std::invalid_argument);
+  s21::set<int> low = {-5, -3};
+  s21_set.compact();
+  s21_set.join(low);
+  EXPECT_EQ(*s21_set.begin(), -5);
+  EXPECT_EQ(s21_set.size(), std_set.size() + 2);
+}
+
+TEST(Set, split_join_lazy_erase) {
+  s21::set<int> lazy, eager;
+  lazy.set_lazy_erase(0.9);
+  for (int i = 0; i < 200; i++) (i < 100 ? lazy : eager).insert(i);
+  for (int i = 1; i < 100; i += 2) lazy.erase(lazy.find(i));
+  eager.join(lazy);
+  EXPECT_EQ(eager.size(), 150);
+  eager.erase(eager.find(100));
+
+  auto rest = eager.split(150);
+  EXPECT_EQ(eager.size(), 99);
+  EXPECT_EQ(rest.size(), 50);
+  lazy.swap(rest);
+  lazy.set_lazy_erase(0.9);
+  for (int i = 150; i < 160; i++) lazy.erase(lazy.find(i));
+  eager.join(lazy);
+  lazy = eager.split(0);
+  EXPECT_TRUE(eager.empty());
+  EXPECT_EQ(lazy.size(), 139);
+  int expected = 0;
+  for (auto it = lazy.begin(); it != lazy.end(); it++) {
+    EXPECT_EQ(*it, expected);
+    expected += expected < 98 ? 2 : expected == 98 ? 3 : 1;
+    if (expected == 150) expected = 160;
+  }
+  EXPECT_EQ(expected, 200);
+}
+
+TEST(Set, split_join_small) {
+  s21::small_set<int, 4> s21_set = {1, 2, 3};
+  auto rest = s21_set.split(2);
+  EXPECT_EQ(s21_set.size(), 1);
+  EXPECT_EQ(rest.size(), 2);
+  s21::small_set<int, 4> big;
+  for (int i = 10; i < 20; i++) big.insert(i);
+  big.join(rest);
+  EXPECT_EQ(big.size(), 12);
+  EXPECT_EQ(*big.begin(), 2);
+  rest.join(big);
+  EXPECT_EQ(rest.size(), 12);
+}
+
+TEST(Set, lazy_erase) {
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  s21_set.set_lazy_erase(0.25);
+  for (int i = 0; i < 3000; i++) {
+    s21_set.insert(i);
+    std_set.insert(i);
+    if (i % 3 == 2) {
+      s21_set.erase(s21_set.begin());
+      std_set.erase(std_set.begin());
+    }
+  }
+  for (int i = 0; i < 3000; i += 7) {
+    auto it = s21_set.find(i);
+    if (it != s21_set.end()) s21_set.erase(it);
+    std_set.erase(i);
+    EXPECT_FALSE(s21_set.contains(i));
+  }
+  for (int i = 1500; i < 2000; i += 5) {
+    s21_set.insert(i);
+    std_set.insert(i);
+  }
+
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  auto std_it = std_set.begin();
+  for (auto it = s21_set.begin(); it != s21_set.end(); it++, std_it++) {
+    EXPECT_EQ(*it, *std_it);
+  }
+  EXPECT_EQ(*s21_set.lower_bound(1001), *std_set.lower_bound(1001));
+
+  s21_set.set_lazy_erase(0);
+  s21_set.erase(s21_set.begin());
+  std_set.erase(std_set.begin());
+  EXPECT_EQ(*s21_set.begin(), *std_set.begin());
+  EXPECT_EQ(s21_set.size(), std_set.size());
+}
+
+TEST(Set, lazy_erase_parallel) {
+  s21::set<int> s21_set;
+  s21_set.set_lazy_erase(0.99);
+  for (int i = 0; i < 1000; i++) s21_set.insert(i);
+  for (int i = 0; i < 1000; i++) {
+    if (i % 10) s21_set.erase(s21_set.find(i));
+  }
+
+  std::atomic<int> visited{0};
+  s21_set.parallel_for_each([&](int item) {
+    EXPECT_EQ(item % 10, 0);
+    visited++;
+  });
+  EXPECT_EQ(visited, 100);
+  EXPECT_EQ(s21_set.parallel_reduce(0LL, std::plus<long long>()), 49500);
+}
+
+TEST(Set, lazy_erase_all) {
+  s21::set<std::string> s21_set = {"a", "b", "c"};
+  s21_set.set_lazy_erase(0.9);
+  s21_set.erase(s21_set.find("b"));
+  EXPECT_EQ(s21_set.size(), 2);
+  EXPECT_EQ(*(++s21_set.begin()), "c");
+  s21_set.insert("b");
+  s21_set.erase(s21_set.begin());
+  s21_set.erase(s21_set.begin());
+  s21_set.erase(s21_set.begin());
+  EXPECT_TRUE(s21_set.empty());
+  EXPECT_TRUE(s21_set.begin() == s21_set.end());
+  s21_set.insert("z");
+  EXPECT_EQ(*s21_set.begin(), "z");
+}
+
+TEST(Set, string_keys) {
+  static_assert(sizeof(Node<std::string, std::greater<std::string>>) <
+                sizeof(Node<std::string, std::less<std::string>>));
+  s21::set<std::string> s21_set;
+  std::set<std::string> std_set;
+  for (int i = 0; i < 500; i++) {
+    auto key = std::string(i % 12, 'x') + char('a' + i % 26);
+    s21_set.insert(key);
+    std_set.insert(key);
+  }
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  auto std_it = std_set.begin();
+  for (auto it = s21_set.begin(); it != s21_set.end(); it++, std_it++) {
+    EXPECT_EQ(*it, *std_it);
+  }
+  s21::set<std::string, std::greater<std::string>> reversed = {"ab", "b"};
+  EXPECT_EQ(*reversed.begin(), "b");
+}
+
 // Multiset tests
 
 TEST(Multiset, constructor_0) {
@@ -1298,6 +1812,433 @@ TEST(Multiset, emplace) {
   EXPECT_EQ(s21_set.size(), 2);
 }
 
+// Multimap tests
+
+TEST(Multimap, insert_0) {
+  s21::multimap<int, std::string> s21_map = {
+      {2, "b"}, {1, "a"}, {2, "bb"}, {3, "c"}};
+  std::multimap<int, std::string> std_map = {
+      {2, "b"}, {1, "a"}, {2, "bb"}, {3, "c"}};
+
+  s21_map.insert(2, "bbb");
+  std_map.insert({2, "bbb"});
+  EXPECT_EQ(s21_map.size(), std_map.size());
+
+  auto stdIt = std_map.begin();
+  for (auto it = s21_map.begin(); it != s21_map.end(); it++, stdIt++) {
+    EXPECT_EQ((*it).first, stdIt->first);
+    EXPECT_EQ((*it).second, stdIt->second);
+  }
+}
+
+TEST(Multimap, equal_range) {
+  s21::multimap<int, int> s21_map;
+  std::multimap<int, int> std_map;
+  for (int i = 0; i < 1000; i++) {
+    s21_map.insert(i % 37, i);
+    std_map.insert({i % 37, i});
+  }
+  for (int i = 0; i < 1000; i += 3) {
+    auto it = s21_map.find(i % 37);
+    s21_map.erase(it);
+    std_map.erase(std_map.find(i % 37));
+  }
+
+  EXPECT_EQ(s21_map.size(), std_map.size());
+  for (int key = -1; key < 40; key++) {
+    EXPECT_EQ(s21_map.count(key), std_map.count(key));
+    auto range = s21_map.equal_range(key);
+    auto std_range = std_map.equal_range(key);
+    for (; range.first != range.second; range.first++, std_range.first++) {
+      EXPECT_EQ((*range.first).second, std_range.first->second);
+    }
+    EXPECT_TRUE(std_range.first == std_range.second);
+  }
+  EXPECT_TRUE(s21_map.find(100) == s21_map.end());
+}
+
+TEST(Multimap, grouped) {
+  s21::grouped_multimap<int, std::string, 4> s21_map;
+  std::multimap<int, std::string> std_map;
+  for (int i = 0; i < 300; i++) {
+    s21_map.insert(i % 7, std::to_string(i) + std::string(20, 'x'));
+    std_map.insert({i % 7, std::to_string(i) + std::string(20, 'x')});
+  }
+  for (int i = 0; i < 300; i += 2) {
+    auto key = i % 5;
+    if (s21_map.contains(key)) {
+      s21_map.erase(s21_map.find(key));
+      std_map.erase(std_map.find(key));
+    }
+  }
+  for (int i = 0; i < 20; i++) {
+    s21_map.erase(s21_map.lower_bound(3));
+    std_map.erase(std_map.lower_bound(3));
+  }
+
+  EXPECT_EQ(s21_map.size(), std_map.size());
+  for (int key = -1; key < 9; key++) {
+    EXPECT_EQ(s21_map.count(key), std_map.count(key));
+    auto range = s21_map.equal_range(key);
+    auto std_range = std_map.equal_range(key);
+    for (; range.first != range.second; range.first++, std_range.first++) {
+      EXPECT_EQ((*range.first).first, std_range.first->first);
+      EXPECT_EQ((*range.first).second, std_range.first->second);
+    }
+    EXPECT_TRUE(std_range.first == std_range.second);
+  }
+
+  auto last = s21_map.lower_bound(6);
+  auto std_last = std_map.lower_bound(6);
+  for (int i = 0; i < 10; i++) {
+    --last;
+    --std_last;
+    EXPECT_EQ((*last).second, std_last->second);
+  }
+
+  s21::grouped_multimap<int, std::string, 4> copy(s21_map);
+  s21_map.compact();
+  copy.merge(s21_map);
+  EXPECT_TRUE(s21_map.empty());
+  EXPECT_EQ(copy.size(), std_map.size() * 2);
+  EXPECT_EQ(copy.count(6), std_map.count(6) * 2);
+}
+
+// Static set tests
+
+TEST(StaticSet, lookup) {
+  s21::vector<int> keys;
+  std::set<int> std_set;
+  for (int i = 0; i < 1000; i++) {
+    keys.push_back(i * 7919 % 3001);
+    std_set.insert(i * 7919 % 3001);
+  }
+  keys.push_back(keys[3]);
+  s21::static_set<int> s21_set(keys);
+
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  for (int key = -2; key < 3005; key++) {
+    EXPECT_EQ(s21_set.contains(key), std_set.count(key) == 1);
+    auto it = s21_set.lower_bound(key);
+    auto std_it = std_set.lower_bound(key);
+    if (std_it == std_set.end()) {
+      EXPECT_TRUE(it == s21_set.end());
+    } else {
+      EXPECT_EQ(*it, *std_it);
+    }
+  }
+
+  auto std_it = std_set.begin();
+  for (auto it = s21_set.begin(); it != s21_set.end(); it++, std_it++) {
+    EXPECT_EQ(*it, *std_it);
+  }
+  EXPECT_TRUE(std_it == std_set.end());
+  EXPECT_EQ(*(--s21_set.end()), *std_set.rbegin());
+}
+
+TEST(StaticSet, from_set) {
+  s21::set<std::string> source = {"pear", "apple", "banana", "fig"};
+  s21::static_set<std::string> s21_set(source);
+  s21::static_set<std::string> empty;
+
+  EXPECT_EQ(s21_set.size(), 4);
+  EXPECT_EQ(*s21_set.begin(), "apple");
+  EXPECT_TRUE(s21_set.contains("fig"));
+  EXPECT_FALSE(s21_set.contains("grape"));
+  EXPECT_TRUE(empty.begin() == empty.end());
+  EXPECT_FALSE(empty.contains("fig"));
+}
+
+TEST(StaticMap, lookup) {
+  s21::map<int, std::string> source;
+  for (int i = 0; i < 100; i++) source.insert(i * 3, std::to_string(i));
+  s21::static_map<int, std::string> s21_map(source);
+
+  EXPECT_EQ(s21_map.size(), 100);
+  EXPECT_EQ(s21_map.at(42), "14");
+  EXPECT_THROW(s21_map.at(43), std::out_of_range);
+  EXPECT_FALSE(s21_map.contains(-3));
+  EXPECT_EQ((*s21_map.lower_bound(43)).first, 45);
+  (*s21_map.find(45)).second = "x";
+  EXPECT_EQ(s21_map.at(45), "x");
+
+  int key = 0;
+  for (auto it = s21_map.begin(); it != s21_map.end(); it++, key += 3) {
+    EXPECT_EQ((*it).first, key);
+  }
+
+  s21::static_map<int, int> small = {{2, 20}, {1, 10}, {2, 30}};
+  EXPECT_EQ(small.size(), 2);
+  EXPECT_EQ(small.at(2), 20);
+}
+
+// Interval map tests
+
+TEST(IntervalMap, insert_0) {
+  s21::interval_map<int, std::string> s21_map;
+  s21::interval_map<int, std::string>::iterator first = s21_map.begin();
+  EXPECT_TRUE(first == s21_map.end());
+
+  auto x = s21_map.insert(1, 5, "first");
+  auto y = s21_map.insert(1, 5, "again");
+  s21_map.insert(0, 3, "second");
+  s21_map.insert(1, 2, "third");
+
+  EXPECT_TRUE(x.second);
+  EXPECT_FALSE(y.second);
+  EXPECT_EQ(s21_map.size(), 3);
+  EXPECT_EQ((*s21_map.find(1, 5)).value, "first");
+  EXPECT_TRUE(s21_map.find(2, 5) == s21_map.end());
+  EXPECT_THROW(s21_map.insert(4, 4, "empty"), std::invalid_argument);
+
+  int lows[] = {0, 1, 1};
+  int i = 0;
+  for (auto it = s21_map.begin(); it != s21_map.end(); it++) {
+    EXPECT_EQ((*it).low, lows[i++]);
+  }
+}
+
+TEST(IntervalMap, find_containing) {
+  s21::interval_map<int, int> s21_map;
+  std::vector<std::pair<int, int>> ranges;
+  for (int i = 0; i < 200; i++) {
+    int low = (i * 37) % 500;
+    int high = low + 1 + (i * 13) % 40;
+    s21_map.insert(low, high, i);
+    ranges.push_back({low, high});
+  }
+
+  for (int point = -5; point < 550; point += 7) {
+    size_t expected = 0;
+    for (auto range : ranges) {
+      if (range.first <= point && point < range.second) expected++;
+    }
+    auto found = s21_map.find_containing(point);
+    EXPECT_EQ(found.size(), expected);
+    for (auto it : found) {
+      EXPECT_TRUE((*it).low <= point && point < (*it).high);
+    }
+  }
+}
+
+TEST(IntervalMap, find_overlapping) {
+  s21::interval_map<int, int> s21_map;
+  std::vector<std::pair<int, int>> ranges;
+  for (int i = 0; i < 200; i++) {
+    int low = (i * 71) % 600;
+    int high = low + 1 + (i * 29) % 50;
+    s21_map.insert(low, high, i);
+    ranges.push_back({low, high});
+  }
+
+  auto it = s21_map.begin();
+  for (int i = 0; i < 100; i++) {
+    auto next = it;
+    next++;
+    next++;
+    auto item = *it;
+    s21_map.erase(it);
+    for (auto range = ranges.begin(); range != ranges.end(); range++) {
+      if (range->first == item.low && range->second == item.high) {
+        ranges.erase(range);
+        break;
+      }
+    }
+    it = s21_map.find((*next).low, (*next).high);
+    if (it == s21_map.end()) break;
+  }
+
+  for (int low = 0; low < 650; low += 11) {
+    int high = low + 25;
+    size_t expected = 0;
+    for (auto range : ranges) {
+      if (range.first < high && low < range.second) expected++;
+    }
+    EXPECT_EQ(s21_map.find_overlapping(low, high).size(), expected);
+  }
+  EXPECT_EQ(s21_map.find_overlapping(10, 10).size(), 0);
+}
+
+// ART map tests
+
+TEST(ArtMap, integer_keys) {
+  s21::art_map<uint64_t, int> s21_map;
+  std::map<uint64_t, int> std_map;
+  uint64_t x = 88172645463325252ull;
+  for (int i = 0; i < 20000; i++) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    uint64_t key = i % 3 ? x : x % 1000;
+    EXPECT_EQ(s21_map.insert(key, i).second, std_map.insert({key, i}).second);
+  }
+  EXPECT_EQ(s21_map.size(), std_map.size());
+  auto std_it = std_map.begin();
+  for (auto it = s21_map.begin(); it != s21_map.end(); it++, std_it++) {
+    EXPECT_EQ((*it).first, std_it->first);
+    EXPECT_EQ((*it).second, std_it->second);
+  }
+  for (uint64_t key : {0ull, 5ull, 999ull, 1000ull, 1ull << 63, ~0ull}) {
+    auto it = s21_map.lower_bound(key);
+    auto std_lb = std_map.lower_bound(key);
+    EXPECT_EQ(it == s21_map.end(), std_lb == std_map.end());
+    if (std_lb != std_map.end()) {
+      EXPECT_EQ((*it).first, std_lb->first);
+    }
+  }
+
+  int step = 0;
+  for (auto it = std_map.begin(); it != std_map.end(); step++) {
+    if (step % 4 == 3) {
+      it++;
+      continue;
+    }
+    s21_map.erase(s21_map.find(it->first));
+    it = std_map.erase(it);
+  }
+  EXPECT_EQ(s21_map.size(), std_map.size());
+  for (auto &item : std_map) EXPECT_EQ(s21_map.at(item.first), item.second);
+  EXPECT_EQ((*(--s21_map.end())).first, std_map.rbegin()->first);
+  EXPECT_THROW(s21_map.at(std_map.begin()->first + 1), std::out_of_range);
+}
+
+TEST(ArtMap, signed_keys) {
+  s21::art_map<int, int> s21_map = {{5, 1}, {-3, 2}, {0, 3}, {-100, 4}};
+  s21_map[7] = 5;
+  int expected[] = {-100, -3, 0, 5, 7};
+  int i = 0;
+  for (auto it = s21_map.begin(); it != s21_map.end(); it++) {
+    EXPECT_EQ((*it).first, expected[i++]);
+  }
+  EXPECT_EQ((*s21_map.upper_bound(-3)).first, 0);
+  EXPECT_EQ((*s21_map.lower_bound(-50)).first, -3);
+  EXPECT_TRUE(s21_map.upper_bound(7) == s21_map.end());
+}
+
+TEST(ArtMap, string_keys) {
+  s21::art_map<std::string, int> s21_map;
+  std::map<std::string, int> std_map;
+  std::string words[] = {"",          "a",          "ab",       "abc",
+                         "abcdefghijklmnop",        "abcdefghijklmnoq",
+                         "abcdefghij", std::string("ab\0", 3), "b",
+                         "\xff",      "http://example.com/a/very/long/path"};
+  for (int round = 0; round < 3; round++) {
+    for (auto &word : words) {
+      auto key = round ? word + std::to_string(round) : word;
+      s21_map.insert(key, round);
+      std_map.insert({key, round});
+    }
+  }
+  EXPECT_EQ(s21_map.size(), std_map.size());
+  auto std_it = std_map.begin();
+  for (auto it = s21_map.begin(); it != s21_map.end(); it++, std_it++) {
+    EXPECT_EQ((*it).first, std_it->first);
+  }
+  for (auto &word : words) {
+    for (auto probe : {word, word + "0", word + "~"}) {
+      auto it = s21_map.lower_bound(probe);
+      auto std_lb = std_map.lower_bound(probe);
+      EXPECT_EQ(it == s21_map.end(), std_lb == std_map.end());
+      if (std_lb != std_map.end()) {
+        EXPECT_EQ((*it).first, std_lb->first);
+      }
+    }
+  }
+
+  for (auto &word : words) {
+    s21_map.erase(s21_map.find(word));
+    std_map.erase(word);
+    EXPECT_FALSE(s21_map.contains(word));
+  }
+  std_it = std_map.begin();
+  for (auto it = s21_map.begin(); it != s21_map.end(); it++, std_it++) {
+    EXPECT_EQ((*it).first, std_it->first);
+    EXPECT_TRUE(s21_map.contains(std_it->first));
+  }
+  s21::art_map<std::string, int> other = {{"a", 9}, {"zz", 9}};
+  s21_map.merge(other);
+  EXPECT_EQ(other.size(), 0);
+  EXPECT_EQ(s21_map.at("zz"), 9);
+  s21_map.clear();
+  EXPECT_TRUE(s21_map.empty());
+}
+
+// Left-right tests
+
+TEST(LeftRight, map) {
+  s21::left_right<s21::map<int, int>> table;
+  std::atomic<bool> done{false};
+  std::atomic<int> errors{0};
+  auto reader = [&] {
+    size_t last = 0;
+    while (!done.load()) {
+      table.read([&](s21::map<int, int> &m) {
+        size_t size = m.size();
+        if (size < last || (size && m.at(int(size) - 1) != int(size))) {
+          errors++;
+        }
+        last = size;
+      });
+    }
+  };
+  std::thread first(reader), second(reader);
+  for (int i = 0; i < 2000; i++) {
+    table.write([i](s21::map<int, int> &m) { m.insert(i, i + 1); });
+  }
+  done = true;
+  first.join();
+  second.join();
+
+  EXPECT_EQ(errors.load(), 0);
+  EXPECT_EQ(table.read([](s21::map<int, int> &m) { return m.size(); }), 2000);
+  auto size = table.write([](s21::map<int, int> &m) {
+    m.erase(m.find(0));
+    return m.size();
+  });
+  EXPECT_EQ(size, 1999);
+  EXPECT_FALSE(table.read([](s21::map<int, int> &m) { return m.contains(0); }));
+}
+
+TEST(LeftRight, set_and_vector) {
+  s21::left_right<s21::set<int>> set(s21::set<int>{1, 2, 3});
+  set.write([](s21::set<int> &s) { s.erase(s.find(2)); });
+  EXPECT_EQ(set.read([](s21::set<int> &s) { return s.size(); }), 2);
+  EXPECT_FALSE(set.read([](s21::set<int> &s) { return s.contains(2); }));
+
+  s21::left_right<s21::vector<int>> vec;
+  for (int i = 0; i < 10; i++) {
+    vec.write([i](s21::vector<int> &v) { v.push_back(i); });
+  }
+  EXPECT_EQ(vec.read([](s21::vector<int> &v) { return v.back(); }), 9);
+  EXPECT_EQ(vec.read([](s21::vector<int> &v) { return v.size(); }), 10);
+}
+
+TEST(LeftRight, throwing_write) {
+  s21::left_right<s21::vector<int>> vec;
+  auto fails_first = [](s21::vector<int> &v) {
+    v.push_back(1);
+    throw std::runtime_error("first");
+  };
+  EXPECT_THROW(vec.write(fails_first), std::runtime_error);
+  EXPECT_TRUE(vec.read([](s21::vector<int> &v) { return v.empty(); }));
+
+  int calls = 0;
+  auto fails_replay = [&calls](s21::vector<int> &v) {
+    v.push_back(2);
+    if (++calls == 2) throw std::runtime_error("replay");
+  };
+  EXPECT_THROW(vec.write(fails_replay), std::runtime_error);
+  for (int i = 0; i < 2; i++) {
+    vec.write([](s21::vector<int> &) {});
+    EXPECT_EQ(vec.read([](s21::vector<int> &v) { return v.size(); }), 1);
+  }
+
+  size_t first = 0, second = 1;
+  std::thread([&first] { first = s21::left_right_slot(); }).join();
+  std::thread([&second] { second = s21::left_right_slot(); }).join();
+  EXPECT_EQ(first, second);
+}
+
 TEST(list, constructor_0) {
   s21::list<int> a;
   for (int i = 1; i < 5; i++) {
@@ -1360,9 +2301,9 @@ TEST(list, push_0) {
     b.push_front(i);
     a.push_front(i);
   }
-  std::list<int>::iterator j = a.end();
-  s21::list<int>::iterator k = b.end();
-  for (int n = 0; n < 10; n++) {
+  std::list<int>::iterator j = a.begin();
+  s21::list<int>::iterator k = b.begin();
+  while (k != b.end()) {
     EXPECT_EQ(*k, *j);
     k++;
     j++;
@@ -1449,7 +2390,8 @@ TEST(list, pop_2) {
   std::list<int>::iterator j = a.begin();
   s21::list<int>::iterator i = b.begin();
 
-  EXPECT_EQ(*i, *j);
+  EXPECT_TRUE(i == b.end());
+  EXPECT_TRUE(j == a.end());
 }
 
 TEST(list, pop_3) {
@@ -1467,7 +2409,8 @@ TEST(list, pop_3) {
   std::list<int>::iterator j = a.begin();
   s21::list<int>::iterator i = b.begin();
 
-  EXPECT_EQ(*i, *j);
+  EXPECT_TRUE(i == b.end());
+  EXPECT_TRUE(j == a.end());
 }
 
 TEST(list, insert_0) {
@@ -1511,7 +2454,7 @@ TEST(list, erase_0) {
 
   j = a.begin();
   i = b.begin();
-  for (int n = 0; n < 10; n++, i++, j++) {
+  for (; i != b.end(); i++, j++) {
     EXPECT_EQ(*i, *j);
   }
 }
@@ -1533,7 +2476,7 @@ TEST(list, erase_1) {
 
   std::list<int>::iterator j = a.begin();
   s21::list<int>::iterator i = b.begin();
-  for (int n = 0; n < 10; n++, i++, j++) {
+  for (; i != b.end(); i++, j++) {
     EXPECT_EQ(*i, *j);
   }
 }
@@ -1557,7 +2500,7 @@ TEST(list, erase_2) {
   i = b.begin();
   j = a.begin();
 
-  for (int n = 0; n < 10; n++, i++, j++) {
+  for (; i != b.end(); i++, j++) {
     EXPECT_EQ(*i, *j);
   }
 }
@@ -1599,7 +2542,8 @@ TEST(list, erase_4) {
   std::list<int>::iterator j = a.begin();
   s21::list<int>::iterator i = b.begin();
 
-  EXPECT_EQ(*i, *j);
+  EXPECT_TRUE(i == b.end());
+  EXPECT_TRUE(j == a.end());
 }
 
 TEST(list, sort_0) {
@@ -1611,13 +2555,55 @@ TEST(list, sort_0) {
 
   std::list<int>::iterator j = a.begin();
   s21::list<int>::iterator i = b.begin();
-  for (int n = 0; n < 20; n++) {
+  while (i != b.end()) {
     EXPECT_EQ(*i, *j);
     i++;
     j++;
   }
 }
 
+TEST(list, sort_stable) {
+  std::list<long> a;
+  s21::list<long> b;
+  for (long i = 0; i < 100000; i++) {
+    long item = i * 7919 % 1013 * 1000000 + i;
+    a.push_back(item);
+    b.push_back(item);
+  }
+  auto by_key = [](long lhs, long rhs) {
+    return lhs / 1000000 < rhs / 1000000;
+  };
+  a.sort(by_key);
+  b.sort(by_key);
+
+  EXPECT_EQ(b.size(), a.size());
+  auto j = a.begin();
+  for (auto i = b.begin(); i != b.end(); i++, j++) {
+    EXPECT_EQ(*i, *j);
+  }
+  auto last = b.end();
+  last--;
+  EXPECT_EQ(*last, a.back());
+}
+
+TEST(list, sort_comparator) {
+  s21::list<int> empty;
+  empty.sort();
+  EXPECT_TRUE(empty.begin() == empty.end());
+
+  s21::list<int> b = {3, 1, 2};
+  b.sort(std::greater<int>());
+  int expected[] = {3, 2, 1};
+  int n = 0;
+  for (auto i = b.begin(); i != b.end(); i++) EXPECT_EQ(*i, expected[n++]);
+  b.push_front(0);
+  b.push_back(4);
+  b.sort();
+  n = 0;
+  for (auto i = b.begin(); i != b.end(); i++) EXPECT_EQ(*i, n++);
+  EXPECT_EQ(n, 5);
+}
+
 TEST(list, unique) {
   std::list<int> a = {1, 2, 3, 3, 3, 3, 4, -1, -2, -33, 44, 3, 3, 3};
   s21::list<int> b = {1, 2, 3, 3, 3, 3, 4, -1, -2, -33, 44, 3, 3, 3};
@@ -1653,11 +2639,42 @@ TEST(list, merge) {
 
   std::list<int>::iterator j = a.begin();
   s21::list<int>::iterator i = b.begin();
-  for (int n = 0; n < 20; n++, i++, j++) {
+  for (; i != b.end(); i++, j++) {
     EXPECT_EQ(*i, *j);
   }
 }
 
+TEST(list, merge_sorted) {
+  std::list<int> a = {1, 3, 5, 5, 9}, aa = {0, 2, 5, 10, 11};
+  s21::list<int> b = {1, 3, 5, 5, 9}, bb = {0, 2, 5, 10, 11};
+  auto first = b.begin();
+
+  b.merge(bb);
+  a.merge(aa);
+
+  EXPECT_TRUE(bb.empty());
+  EXPECT_TRUE(bb.begin() == bb.end());
+  EXPECT_EQ(b.size(), 10);
+  EXPECT_EQ(*first, 1);
+  std::list<int>::iterator j = a.begin();
+  for (auto i = b.begin(); i != b.end(); i++, j++) {
+    EXPECT_EQ(*i, *j);
+  }
+  EXPECT_EQ(b.back(), 11);
+
+  s21::list<int> empty, desc = {9, 4, 1};
+  empty.merge(desc, std::greater<int>());
+  EXPECT_EQ(empty.size(), 3);
+  EXPECT_EQ(empty.front(), 9);
+  s21::list<int> more = {7, 0};
+  empty.merge(more, std::greater<int>());
+  int expected[] = {9, 7, 4, 1, 0};
+  int n = 0;
+  for (auto i = empty.begin(); i != empty.end(); i++) {
+    EXPECT_EQ(*i, expected[n++]);
+  }
+}
+
 TEST(list, swap) {
   s21::list<int> a = {5, 6, 3};
   s21::list<int> b = {1, 2, 3, 4, 5, 6};
@@ -1669,7 +2686,7 @@ TEST(list, swap) {
 
   std::list<int>::iterator j = aa.begin();
   s21::list<int>::iterator i = a.begin();
-  for (int n = 0; n < 10; n++, i++, j++) {
+  for (; i != a.end(); i++, j++) {
     EXPECT_EQ(*i, *j);
   }
 }
@@ -1689,7 +2706,7 @@ TEST(list, splice) {
 
   std::list<int>::iterator j = a.begin();
   s21::list<int>::iterator i = b.begin();
-  for (int n = 0; n < 20; n++, i++, j++) {
+  for (; i != b.end(); i++, j++) {
     EXPECT_EQ(*i, *j);
   }
 }
@@ -1717,6 +2734,594 @@ TEST(list, emplace) {
   EXPECT_EQ(a.max_size(), a.max_size());
 }
 
+TEST(list, move_noexcept) {
+  static_assert(std::is_nothrow_default_constructible<s21::list<int>>::value);
+  static_assert(std::is_nothrow_move_constructible<s21::list<int>>::value);
+  static_assert(std::is_nothrow_move_assignable<s21::list<int>>::value);
+
+  s21::list<std::string> a = {"a", "b", "c"};
+  auto first = a.begin();
+  s21::list<std::string> b(std::move(a));
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(a.begin() == a.end());
+  EXPECT_EQ(*first, "a");
+  std::string joined;
+  for (auto i = b.begin(); i != b.end(); i++) joined += *i;
+  EXPECT_EQ(joined, "abc");
+  auto last = b.end();
+  last--;
+  EXPECT_EQ(*last, "c");
+
+  s21::list<std::string> c = {"x"};
+  c = std::move(b);
+  EXPECT_EQ(c.size(), 3);
+  EXPECT_EQ(c.back(), "c");
+  c.swap(a);
+  EXPECT_TRUE(c.begin() == c.end());
+  a.push_back("d");
+  a.reverse();
+  EXPECT_EQ(a.front(), "d");
+  EXPECT_EQ(a.back(), "a");
+
+  s21::list<std::string> d;
+  d = a;
+  d.pop_front();
+  EXPECT_EQ(d.size(), 3);
+  EXPECT_EQ(a.size(), 4);
+}
+
+TEST(list, move_only) {
+  s21::list<std::unique_ptr<int>> a;
+  auto two = std::make_unique<int>(2);
+  a.push_back(std::move(two));
+  a.emplace_back(new int(3), std::make_unique<int>(4));
+  a.emplace_front(std::make_unique<int>(1));
+  auto it = a.begin();
+  it++;
+  auto added = a.insert(it, std::make_unique<int>(5));
+  EXPECT_EQ(**added, 5);
+  EXPECT_EQ(two, nullptr);
+  int expected[] = {1, 5, 2, 3, 4};
+  int n = 0;
+  for (auto i = a.begin(); i != a.end(); i++) EXPECT_EQ(**i, expected[n++]);
+  EXPECT_EQ(n, 5);
+
+  s21::list<std::string> b;
+  b.emplace_back("abc");
+  std::string moved = "def";
+  b.push_front(std::move(moved));
+  EXPECT_EQ(b.front(), "def");
+  EXPECT_EQ(b.back(), "abc");
+
+  s21::queue<std::unique_ptr<int>> q;
+  q.push(std::make_unique<int>(7));
+  EXPECT_EQ(*q.front(), 7);
+  q.pop();
+  EXPECT_TRUE(q.empty());
+}
+
+template <class T>
+struct counting_allocator {
+  using value_type = T;
+  int *live;
+
+  explicit counting_allocator(int *counter) : live(counter) {}
+  template <class U>
+  counting_allocator(const counting_allocator<U> &other) : live(other.live) {}
+
+  T *allocate(size_t n) {
+    *live += n;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, size_t n) {
+    *live -= n;
+    std::allocator<T>().deallocate(p, n);
+  }
+  bool operator==(const counting_allocator &other) const {
+    return live == other.live;
+  }
+  bool operator!=(const counting_allocator &other) const {
+    return live != other.live;
+  }
+};
+
+TEST(list, allocator) {
+  int live = 0, other_live = 0;
+  counting_allocator<int> alloc(&live), other_alloc(&other_live);
+  {
+    s21::list<int, counting_allocator<int>> a({1, 2, 3}, alloc);
+    EXPECT_EQ(live, 3);
+    s21::list<int, counting_allocator<int>> b(a);
+    EXPECT_EQ(live, 6);
+    EXPECT_TRUE(b.get_allocator() == alloc);
+    s21::list<int, counting_allocator<int>> c(std::move(b));
+    EXPECT_EQ(live, 6);
+    a.pop_front();
+    EXPECT_EQ(live, 5);
+
+    s21::list<int, counting_allocator<int>> d(other_alloc);
+    d.push_back(7);
+    d = std::move(c);
+    EXPECT_EQ(other_live, 3);
+    EXPECT_EQ(live, 2);
+    EXPECT_EQ(d.back(), 3);
+    d = a;
+    EXPECT_EQ(other_live, 2);
+    EXPECT_EQ(d.front(), 2);
+
+    using counted_list = s21::list<int, counting_allocator<int>>;
+    s21::queue<int, counted_list> q(alloc);
+    q.push(1);
+    q.push(2);
+    q.pop();
+    s21::stack<int, counted_list> s(counted_list(2, alloc));
+    EXPECT_EQ(live, 5);
+  }
+  EXPECT_EQ(live, 0);
+  EXPECT_EQ(other_live, 0);
+}
+
+TEST(list, compact) {
+  int live = 0;
+  counting_allocator<std::string> alloc(&live);
+  {
+    s21::list<std::string, counting_allocator<std::string>> a(alloc), b(alloc);
+    for (int i = 0; i < 100; i++) a.push_back(std::to_string(i));
+    a.compact();
+    EXPECT_EQ(live, 101);
+    auto first = reinterpret_cast<char *>(&*a.begin());
+    auto stride = reinterpret_cast<char *>(&*++a.begin()) - first;
+    EXPECT_GE(stride, sizeof(std::string));
+    int n = 0;
+    for (auto i = a.begin(); i != a.end(); i++, n++) {
+      EXPECT_EQ(*i, std::to_string(n));
+      EXPECT_EQ(reinterpret_cast<char *>(&*i), first + n * stride);
+    }
+    auto it = a.begin();
+    it++;
+    a.erase(it);
+    a.push_front("front");
+    b.push_back("b");
+    b.splice(b.end(), a);
+    EXPECT_EQ(b.size(), 101);
+    EXPECT_EQ(live, 103);
+    b.reverse();
+    b.compact();
+    EXPECT_EQ(live, 102);
+    EXPECT_EQ(b.front(), "99");
+    EXPECT_EQ(b.back(), "b");
+    while (b.size() > 1) b.pop_back();
+    EXPECT_EQ(live, 102);
+    b.pop_back();
+    EXPECT_EQ(live, 0);
+  }
+  EXPECT_EQ(live, 0);
+
+  s21::list<int> c;
+  c.set_auto_compact(0.5);
+  for (int i = 0; i < 1000; i++) c.push_back(i);
+  for (int i = 0; i < 1000; i++) {
+    c.pop_front();
+    c.push_back(i + 1000);
+  }
+  auto stride = sizeof(s21::Node<int>);
+  int contiguous = 0;
+  for (auto i = c.begin(), j = ++c.begin(); j != c.end(); i++, j++) {
+    auto gap = reinterpret_cast<char *>(&*j) - reinterpret_cast<char *>(&*i);
+    if (gap == stride) contiguous++;
+  }
+  EXPECT_GT(contiguous, 400);
+  EXPECT_EQ(c.size(), 1000);
+  EXPECT_EQ(c.front(), 1000);
+  s21::list<int> d(std::move(c));
+  d.sort();
+  EXPECT_EQ(d.back(), 1999);
+
+  s21::list<std::string> e;
+  e.set_auto_compact(0.5);
+  e.push_back("self");
+  for (int i = 0; i < 100; i++) e.push_back(e.front());
+  for (auto &item : e) EXPECT_EQ(item, "self");
+}
+
+TEST(unrolled_list, against_std_list) {
+  s21::unrolled_list<int, 32> a;
+  std::list<int> b;
+  unsigned x = 12345;
+  for (int step = 0; step < 20000; step++) {
+    x = x * 1103515245 + 12345;
+    size_t pos = b.empty() ? 0 : (x >> 8) % (b.size() + 1);
+    auto i = a.begin();
+    auto j = b.begin();
+    for (size_t k = 0; k < pos && k < 40; k++, i++, j++) {
+    }
+    if (x % 5 < 3 || b.empty()) {
+      EXPECT_EQ(*a.insert(i, step), step);
+      b.insert(j, step);
+    } else if (j != b.end()) {
+      auto next = a.erase(i);
+      j = b.erase(j);
+      EXPECT_EQ(next == a.end(), j == b.end());
+      if (j != b.end()) {
+        EXPECT_EQ(*next, *j);
+      }
+    }
+  }
+  EXPECT_EQ(a.size(), b.size());
+  auto j = b.begin();
+  for (auto i = a.begin(); i != a.end(); i++, j++) EXPECT_EQ(*i, *j);
+  auto r = b.rbegin();
+  for (auto i = a.end(); i != a.begin(); r++) EXPECT_EQ(*--i, *r);
+  EXPECT_EQ(a.front(), b.front());
+  EXPECT_EQ(a.back(), b.back());
+}
+
+TEST(unrolled_list, push_pop_splice) {
+  s21::unrolled_list<std::string, 64> a = {"a", "b", "c"};
+  s21::unrolled_list<std::string, 64> b;
+  for (int i = 0; i < 10; i++) b.push_back(std::to_string(i));
+  b.push_front("front");
+  b.pop_back();
+  EXPECT_EQ(b.front(), "front");
+  EXPECT_EQ(b.back(), "8");
+
+  auto pos = a.begin();
+  pos++;
+  a.splice(pos, b);
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(a.size(), 13);
+  std::string joined;
+  for (const auto &item : a) joined += item;
+  EXPECT_EQ(joined, "afront012345678bc");
+
+  s21::unrolled_list<std::string, 64> c(a);
+  c.splice(c.end(), a);
+  EXPECT_EQ(c.size(), 26);
+  EXPECT_EQ(c.back(), "c");
+  while (!c.empty()) c.pop_front();
+  EXPECT_TRUE(c.begin() == c.end());
+  c.emplace_back("x", "y");
+  EXPECT_EQ(c.front(), "x");
+
+  c.insert(++c.begin(), *--c.end());
+  c.insert(c.begin(), std::move(*--c.end()));
+  joined.clear();
+  for (const auto &item : c) joined += item;
+  EXPECT_EQ(joined, "yxy");
+
+  s21::unrolled_list<std::unique_ptr<int>> owners;
+  owners.emplace_back(std::make_unique<int>(2), std::make_unique<int>(3));
+  owners.push_front(std::make_unique<int>(1));
+  int n = 1;
+  for (auto &owner : owners) EXPECT_EQ(*owner, n++);
+}
+
+struct Connection {
+  int id;
+  s21::intrusive_list_hook state;
+  s21::intrusive_list_hook all;
+};
+
+TEST(intrusive_list, link_unlink) {
+  using by_state = s21::intrusive_list<Connection, &Connection::state>;
+  Connection conns[6];
+  by_state idle, active;
+  s21::intrusive_list<Connection, &Connection::all> all;
+  for (int i = 0; i < 6; i++) {
+    conns[i].id = i;
+    idle.push_back(conns[i]);
+    all.push_front(conns[i]);
+  }
+  EXPECT_EQ(idle.size(), 6);
+  EXPECT_EQ(all.front().id, 5);
+
+  idle.erase(conns[2]);
+  active.push_back(conns[2]);
+  active.splice(active.begin(), idle, idle.iterator_to(conns[4]));
+  EXPECT_TRUE(conns[4].state.is_linked());
+  EXPECT_EQ(idle.size(), 4);
+  EXPECT_EQ(active.size(), 2);
+  EXPECT_EQ(active.front().id, 4);
+
+  int expected[] = {0, 1, 3, 5};
+  int n = 0;
+  for (auto &conn : idle) EXPECT_EQ(conn.id, expected[n++]);
+  idle.reverse();
+  auto it = idle.begin();
+  EXPECT_EQ(it->id, 5);
+  EXPECT_EQ((it++)->id, 5);
+  EXPECT_EQ(it->id, 3);
+  it = idle.erase(it);
+  EXPECT_EQ(it->id, 1);
+  EXPECT_FALSE(conns[3].state.is_linked());
+
+  idle.splice(idle.end(), active);
+  EXPECT_TRUE(active.empty());
+  EXPECT_EQ(idle.back().id, 2);
+  by_state moved(std::move(idle));
+  EXPECT_TRUE(idle.begin() == idle.end());
+  EXPECT_EQ(moved.size(), 5);
+  moved.pop_front();
+  moved.pop_back();
+  EXPECT_EQ(moved.front().id, 1);
+  EXPECT_EQ(all.size(), 6);
+  moved.clear();
+  EXPECT_FALSE(conns[1].state.is_linked());
+  EXPECT_TRUE(conns[1].all.is_linked());
+}
+
+TEST(timer_wheel, fires_on_deadline) {
+  s21::timer_wheel<std::function<void()>, 2, 3> wheel;
+  std::vector<uint64_t> deadline, fired_at;
+  std::vector<s21::timer_wheel<std::function<void()>, 2, 3>::handle> handles;
+  unsigned x = 7;
+  for (int i = 0; i < 500; i++) {
+    x = x * 1103515245 + 12345;
+    uint64_t delay = (x >> 8) % 200;
+    deadline.push_back(wheel.now() + (delay ? delay : 1));
+    fired_at.push_back(0);
+    handles.push_back(wheel.schedule(
+        delay, [&wheel, &fired_at, i] { fired_at[i] = wheel.now(); }));
+    if (i % 7 == 0) wheel.advance(x % 5);
+  }
+  int cancelled = 0;
+  for (int i = 0; i < 500; i += 3) {
+    if (wheel.cancel(handles[i])) {
+      cancelled++;
+      deadline[i] = 0;
+    }
+    EXPECT_FALSE(wheel.cancel(handles[i]));
+    EXPECT_FALSE(wheel.pending(handles[i]));
+  }
+  EXPECT_EQ(wheel.size() + cancelled,
+            500 - std::count_if(fired_at.begin(), fired_at.end(),
+                                [](uint64_t t) { return t != 0; }));
+  size_t fired = 0;
+  while (!wheel.empty()) fired += wheel.advance();
+  for (int i = 0; i < 500; i++) EXPECT_EQ(fired_at[i], deadline[i]);
+  EXPECT_FALSE(wheel.cancel(decltype(wheel)::handle()));
+  EXPECT_GT(fired, 0);
+}
+
+TEST(timer_wheel, callbacks_reschedule_and_cancel) {
+  s21::timer_wheel<> wheel;
+  int ticks = 0;
+  std::function<void()> repeat = [&] {
+    ticks++;
+    if (ticks < 5) wheel.schedule(300, repeat);
+  };
+  wheel.schedule(0, repeat);
+  decltype(wheel)::handle victim;
+  wheel.schedule(1, [&] { EXPECT_TRUE(wheel.cancel(victim)); });
+  victim = wheel.schedule(1, [] { FAIL(); });
+  EXPECT_EQ(wheel.advance(), 2);
+  EXPECT_EQ(ticks, 1);
+  EXPECT_EQ(wheel.advance(299), 0);
+  EXPECT_EQ(wheel.advance(), 1);
+  EXPECT_EQ(wheel.advance(2000), 3);
+  EXPECT_EQ(ticks, 5);
+  EXPECT_TRUE(wheel.empty());
+
+  s21::timer_wheel<std::function<void()>, 2, 2> small;
+  small.schedule(small.maxDelay + 100, [&] { ticks = 0; });
+  EXPECT_EQ(small.advance(small.maxDelay + 99), 0);
+  EXPECT_EQ(ticks, 5);
+  EXPECT_EQ(small.advance(), 1);
+  EXPECT_EQ(ticks, 0);
+}
+
+TEST(timer_wheel, throwing_callback) {
+  s21::timer_wheel<> wheel;
+  int fired = 0;
+  wheel.schedule(1, [] { throw std::runtime_error("timer"); });
+  auto kept = wheel.schedule(1, [&] { fired++; });
+  auto dropped = wheel.schedule(1, [&] { fired += 10; });
+  EXPECT_THROW(wheel.advance(), std::runtime_error);
+  EXPECT_EQ(wheel.size(), 2);
+  EXPECT_TRUE(wheel.pending(kept));
+  EXPECT_TRUE(wheel.cancel(dropped));
+  EXPECT_EQ(wheel.advance(), 1);
+  EXPECT_EQ(fired, 1);
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(lru_cache, evicts_least_recent) {
+  s21::lru_cache<int, std::string> cache(3);
+  std::vector<int> evicted;
+  cache.set_eviction_callback(
+      [&](const int &key, std::string &) { evicted.push_back(key); });
+  cache.put(1, "one");
+  cache.put(2, "two");
+  cache.put(3, "three");
+  EXPECT_EQ(*cache.get(1), "one");
+  cache.put(4, "four");
+  EXPECT_EQ(cache.get(2), nullptr);
+  EXPECT_EQ(evicted, std::vector<int>({2}));
+  cache.put(3, "THREE");
+  cache.put(5, "five");
+  EXPECT_EQ(evicted, std::vector<int>({2, 1}));
+  EXPECT_EQ(*cache.get(3), "THREE");
+  EXPECT_TRUE(cache.contains(4));
+  EXPECT_TRUE(cache.erase(4));
+  EXPECT_FALSE(cache.erase(4));
+  EXPECT_EQ(cache.size(), 2);
+  cache.set_capacity(1);
+  EXPECT_EQ(evicted, std::vector<int>({2, 1, 5}));
+
+  for (int i = 0; i < 1000; i++) cache.put(i, std::to_string(i));
+  cache.set_capacity(1000);
+  for (int i = 0; i < 1000; i++) cache.put(i, std::to_string(i));
+  EXPECT_EQ(cache.size(), 1000);
+  for (int i = 0; i < 1000; i += 2) EXPECT_EQ(*cache.get(i), std::to_string(i));
+  for (int i = 1000; i < 1500; i++) cache.put(i, std::to_string(i));
+  for (int i = 0; i < 1000; i++) EXPECT_EQ(cache.contains(i), i % 2 == 0);
+}
+
+TEST(lru_cache, weighted) {
+  s21::lru_cache<std::string, std::string> cache(
+      10, [](const std::string &, const std::string &value) {
+        return value.size();
+      });
+  EXPECT_TRUE(cache.put("a", "aaaa"));
+  EXPECT_TRUE(cache.put("b", "bbbb"));
+  EXPECT_EQ(cache.weight(), 8);
+  EXPECT_TRUE(cache.put("c", "ccc"));
+  EXPECT_FALSE(cache.contains("a"));
+  EXPECT_EQ(cache.weight(), 7);
+  EXPECT_FALSE(cache.put("b", "bbbbbbbbbbb"));
+  EXPECT_FALSE(cache.contains("b"));
+  EXPECT_EQ(cache.weight(), 3);
+  cache.clear();
+  EXPECT_TRUE(cache.empty());
+  EXPECT_EQ(cache.weight(), 0);
+
+  s21::lru_cache<int, std::unique_ptr<int>> owners(2);
+  owners.put(1, std::make_unique<int>(1));
+  EXPECT_EQ(**owners.get(1), 1);
+}
+
+TEST(lru_cache, allocator) {
+  int live = 0;
+  using alloc_type = counting_allocator<std::pair<const int, int>>;
+  {
+    s21::lru_cache<int, int, std::hash<int>, std::equal_to<int>, alloc_type>
+        cache(2, alloc_type(&live));
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.put(3, 3);
+    EXPECT_EQ(live, 2);
+    EXPECT_TRUE(cache.get_allocator() == alloc_type(&live));
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(lru_cache, sharded) {
+  s21::sharded_lru_cache<int, int, 4> cache(16000);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&cache, t] {
+      for (int i = 0; i < 2000; i++) {
+        cache.put(t * 2000 + i, i);
+        auto value = cache.get(t * 2000 + i);
+        EXPECT_TRUE(value && *value == i);
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  EXPECT_EQ(cache.size(), 8000);
+  EXPECT_EQ(*cache.get(7999), 1999);
+  EXPECT_TRUE(cache.erase(7999));
+  EXPECT_FALSE(cache.get(7999).has_value());
+
+  s21::sharded_lru_cache<int, int, 4> small(40);
+  int evicted = 0;
+  small.set_eviction_callback([&](const int &, int &) { evicted++; });
+  for (int i = 0; i < 1000; i++) small.put(i, i);
+  EXPECT_LE(small.size(), 40);
+  EXPECT_EQ(evicted + small.size(), 1000);
+  EXPECT_EQ(*small.get(999), 999);
+
+  EXPECT_THROW((s21::sharded_lru_cache<int, int, 4>(3)), std::invalid_argument);
+  s21::sharded_lru_cache<int, int, 4> tiny(4);
+  for (int i = 0; i < 100; i++) EXPECT_TRUE(tiny.put(i, i));
+  EXPECT_LE(tiny.size(), 4);
+}
+
+TEST(deque, against_std_deque) {
+  s21::deque<std::string> a;
+  std::deque<std::string> b;
+  unsigned x = 4242;
+  for (int step = 0; step < 20000; step++) {
+    x = x * 1103515245 + 12345;
+    auto item = std::to_string(step);
+    switch ((x >> 8) % 6) {
+      case 0:
+      case 1:
+        a.push_back(item);
+        b.push_back(item);
+        break;
+      case 2:
+      case 3:
+        a.emplace_front(item);
+        b.emplace_front(item);
+        break;
+      case 4:
+        if (!b.empty()) {
+          a.pop_back();
+          b.pop_back();
+        }
+        break;
+      default:
+        if (!b.empty()) {
+          a.pop_front();
+          b.pop_front();
+        }
+    }
+    ASSERT_EQ(a.size(), b.size());
+    if (!b.empty()) {
+      size_t i = x % b.size();
+      ASSERT_EQ(a[i], b[i]);
+    }
+  }
+  EXPECT_EQ(a.front(), b.front());
+  EXPECT_EQ(a.back(), b.back());
+  EXPECT_EQ(a.end() - a.begin(), b.size());
+  auto j = b.begin();
+  for (auto i = a.begin(); i != a.end(); ++i, ++j) EXPECT_EQ(*i, *j);
+  auto r = b.rbegin();
+  for (auto i = a.rbegin(); i != a.rend(); ++i, ++r) EXPECT_EQ(*i, *r);
+  for (size_t k = 0; k < b.size(); k += 7) {
+    EXPECT_EQ(*(a.begin() + k), b[k]);
+    EXPECT_EQ(*(a.end() - (b.size() - k)), b[k]);
+  }
+  EXPECT_THROW(a.at(b.size()), std::out_of_range);
+}
+
+TEST(deque, references_stay_valid) {
+  s21::deque<int> a = {1, 2, 3};
+  int &first = a.front();
+  for (int i = 0; i < 10000; i++) {
+    a.push_back(i);
+    a.push_front(-i);
+  }
+  EXPECT_EQ(first, 1);
+  EXPECT_EQ(a.size(), 20003);
+  EXPECT_EQ(a[10000], 1);
+  std::sort(a.begin(), a.end());
+  EXPECT_EQ(a.front(), -9999);
+  EXPECT_EQ(a.back(), 9999);
+
+  s21::deque<int> copy(a), moved(std::move(a));
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(a.begin() == a.end());
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), moved.begin()));
+  copy.resize(5);
+  copy.clear();
+  copy.shrink_to_fit();
+  copy.push_front(7);
+  EXPECT_EQ(copy.back(), 7);
+  moved = copy;
+  EXPECT_EQ(moved.size(), 1);
+  copy.swap(a);
+  EXPECT_EQ(a.front(), 7);
+  const s21::deque<int> view(3, 4);
+  EXPECT_EQ(std::distance(view.begin(), view.end()), 3);
+  EXPECT_EQ(view.at(2), 4);
+
+  int live = 0;
+  {
+    s21::deque<int, counting_allocator<int>> counted{
+        counting_allocator<int>(&live)};
+    for (int i = 0; i < 1000; i++) counted.push_back(i);
+    for (int i = 0; i < 1000; i++) {
+      counted.pop_front();
+      counted.push_back(i);
+    }
+    EXPECT_LT(live, 1000 + 8 * s21::deque<int>::blockSize);
+  }
+  EXPECT_EQ(live, 0);
+}
+
 TEST(queu, constructor_0) {
   std::size_t num = 10;
   s21::queue<int> a(num);
@@ -1789,6 +3394,73 @@ TEST(queue, emplace) {
   ASSERT_EQ(b.back(), 4);
 }
 
+TEST(queue, ring_buffer) {
+  s21::ring_buffer<std::string> ring;
+  std::deque<std::string> model;
+  unsigned x = 99;
+  for (int step = 0; step < 5000; step++) {
+    x = x * 1103515245 + 12345;
+    auto item = std::to_string(step);
+    switch ((x >> 8) % 5) {
+      case 0:
+        ring.push_front(item);
+        model.push_front(item);
+        break;
+      case 1:
+      case 2:
+        ring.emplace_back(item);
+        model.push_back(item);
+        break;
+      case 3:
+        if (!model.empty()) {
+          ring.pop_front();
+          model.pop_front();
+        }
+        break;
+      default:
+        if (!model.empty()) {
+          ring.pop_back();
+          model.pop_back();
+        }
+    }
+    ASSERT_EQ(ring.size(), model.size());
+  }
+  for (size_t i = 0; i < model.size(); i++) EXPECT_EQ(ring[i], model[i]);
+  ring.push_back(ring.front());
+  EXPECT_EQ(ring.back(), model.front());
+  s21::ring_buffer<std::string> copy(ring);
+  EXPECT_TRUE(copy == ring);
+  copy.pop_back();
+  EXPECT_FALSE(copy == ring);
+}
+
+TEST(queue, containers) {
+  s21::queue<std::unique_ptr<int>> owners;
+  for (int i = 0; i < 100; i++) owners.push(std::make_unique<int>(i));
+  for (int i = 0; i < 50; i++) owners.pop();
+  for (int i = 100; i < 150; i++) owners.push(std::make_unique<int>(i));
+  EXPECT_EQ(*owners.front(), 50);
+  EXPECT_EQ(*owners.back(), 149);
+  EXPECT_EQ(owners.size(), 100);
+
+  s21::queue<int, s21::list<int>> linked = {1, 2, 3};
+  linked.emplace_back(4, 5);
+  linked.pop();
+  EXPECT_EQ(linked.front(), 2);
+  EXPECT_EQ(linked.back(), 5);
+  s21::queue<int> ring = {2, 3, 4, 5};
+  EXPECT_TRUE(ring == s21::queue<int>({2, 3, 4, 5}));
+
+  s21::stack<int, s21::list<int>> stacked = {1, 2};
+  stacked.push(3);
+  EXPECT_EQ(stacked.top(), 3);
+  stacked.pop();
+  stacked.pop();
+  stacked.pop();
+  stacked.pop();
+  EXPECT_TRUE(stacked.empty());
+}
+
 TEST(stack, constructor_0) {
   s21::stack<int> b{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
   for (int i = 10; i > 0; i--) {
@@ -1891,7 +3563,7 @@ TEST(stack, swap) {
   a.swap(a2);
 
   ASSERT_TRUE(a.size() == 4 && a2.size() == 3);
-  ASSERT_TRUE(a.front() == 4 && a2.front() == 1);
+  ASSERT_TRUE(a.top() == 7 && a2.top() == 3);
 }
 
 TEST(stack, emplace) {
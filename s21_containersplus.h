@@ -2,4 +2,14 @@
 #pragma once
 
 #include "s21_array.h"
-#include "s21_multiset.h"
\ No newline at end of file
+#include "s21_art_map.h"
+#include "s21_deque.h"
+#include "s21_interval_map.h"
+#include "s21_intrusive_list.h"
+#include "s21_left_right.h"
+#include "s21_lru_cache.h"
+#include "s21_multimap.h"
+#include "s21_multiset.h"
+#include "s21_static_set.h"
+#include "s21_timer_wheel.h"
+#include "s21_unrolled_list.h"
\ No newline at end of file
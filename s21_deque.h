@@ -0,0 +1,471 @@
+#ifndef S21_DEQUE_H_
+#define S21_DEQUE_H_
+
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Elements live in fixed-size blocks; a map of block pointers, kept with
+// free room at both ends, gives O(1) indexing. Growing at either end only
+// adds a block or moves the block pointers into a larger map, so elements
+// never relocate and references stay valid across push_front and
+// push_back. Emptied blocks are kept for reuse, up to spareBlocks of them.
+template <class T, class Allocator = std::allocator<T>>
+class deque {
+ private:
+  using allocator_traits = std::allocator_traits<Allocator>;
+  using map_allocator =
+      typename allocator_traits::template rebind_alloc<T *>;
+  using map_traits = std::allocator_traits<map_allocator>;
+
+  static constexpr size_t blockBytes = 512;
+
+ public:
+  static constexpr size_t blockSize =
+      sizeof(T) * 16 >= blockBytes ? 16 : blockBytes / sizeof(T);
+  static constexpr size_t spareBlocks = 4;
+
+ private:
+  template <bool IsConst>
+  class common_iterator {
+    friend deque;
+    template <bool IsConstFriend>
+    friend class common_iterator;
+
+   public:
+    using difference_type = ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<IsConst, const T *, T *>;
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+    using iterator_category = std::random_access_iterator_tag;
+
+    common_iterator() noexcept {}
+
+    operator common_iterator<true>() const noexcept {
+      return common_iterator<true>(_node, _cur);
+    }
+
+    reference operator*() const { return *_cur; }
+    pointer operator->() const { return _cur; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    common_iterator &operator++() {
+      if (++_cur == *_node + blockSize) {
+        ++_node;
+        _cur = *_node;
+      }
+      return *this;
+    }
+
+    common_iterator &operator--() {
+      if (_cur == *_node) {
+        --_node;
+        _cur = *_node + blockSize;
+      }
+      --_cur;
+      return *this;
+    }
+
+    common_iterator operator++(int) {
+      auto iter = *this;
+      ++(*this);
+      return iter;
+    }
+
+    common_iterator operator--(int) {
+      auto iter = *this;
+      --(*this);
+      return iter;
+    }
+
+    common_iterator &operator+=(difference_type n) {
+      difference_type offset = (_cur - *_node) + n;
+      difference_type block = static_cast<difference_type>(blockSize);
+      if (offset >= 0 && offset < block) {
+        _cur += n;
+      } else {
+        difference_type step =
+            offset >= 0 ? offset / block : -((-offset - 1) / block) - 1;
+        _node += step;
+        _cur = *_node + (offset - step * block);
+      }
+      return *this;
+    }
+
+    common_iterator &operator-=(difference_type n) { return *this += -n; }
+
+    common_iterator operator+(difference_type n) const {
+      auto iter = *this;
+      return iter += n;
+    }
+
+    common_iterator operator-(difference_type n) const {
+      auto iter = *this;
+      return iter -= n;
+    }
+
+    difference_type operator-(const common_iterator &other) const {
+      return (_node - other._node) * static_cast<difference_type>(blockSize) +
+             (_cur - *_node) - (other._cur - *other._node);
+    }
+
+    bool operator==(const common_iterator &other) const noexcept {
+      return _cur == other._cur && _node == other._node;
+    }
+    bool operator!=(const common_iterator &other) const noexcept {
+      return !(*this == other);
+    }
+    bool operator<(const common_iterator &other) const noexcept {
+      return _node == other._node ? _cur < other._cur : _node < other._node;
+    }
+    bool operator>(const common_iterator &other) const noexcept {
+      return other < *this;
+    }
+    bool operator<=(const common_iterator &other) const noexcept {
+      return !(other < *this);
+    }
+    bool operator>=(const common_iterator &other) const noexcept {
+      return !(*this < other);
+    }
+
+   private:
+    common_iterator(T **node, T *cur) noexcept : _node(node), _cur(cur) {}
+
+    T **_node = nullptr;
+    T *_cur = nullptr;
+  };
+
+ public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = common_iterator<false>;
+  using const_iterator = common_iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  deque() noexcept(noexcept(Allocator())) : deque(Allocator()) {}
+
+  explicit deque(const Allocator &alloc) noexcept : _allocator(alloc) {}
+
+  deque(size_type count, const T &value, const Allocator &alloc = Allocator())
+      : _allocator(alloc) {
+    while (_size != count) push_back(value);
+  }
+
+  explicit deque(size_type count, const Allocator &alloc = Allocator())
+      : _allocator(alloc) {
+    while (_size != count) emplace_back();
+  }
+
+  template <class InputIt,
+            std::enable_if_t<!std::is_integral<InputIt>::value, bool> = true>
+  deque(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+      : _allocator(alloc) {
+    for (; first != last; ++first) push_back(*first);
+  }
+
+  deque(std::initializer_list<T> init, const Allocator &alloc = Allocator())
+      : deque(init.begin(), init.end(), alloc) {}
+
+  deque(const deque &other)
+      : deque(other, allocator_traits::select_on_container_copy_construction(
+                         other.get_allocator())) {}
+
+  deque(const deque &other, const Allocator &alloc) : _allocator(alloc) {
+    for (const auto &item : other) push_back(item);
+  }
+
+  deque(deque &&other) noexcept : _allocator(std::move(other._allocator)) {
+    swapStorage(other);
+  }
+
+  ~deque() {
+    clear();
+    releaseStorage();
+  }
+
+  deque &operator=(const deque &other) {
+    if (this == &other) return *this;
+    clear();
+    if (allocator_traits::propagate_on_container_copy_assignment::value &&
+        _allocator != other._allocator) {
+      releaseStorage();
+      _allocator = other._allocator;
+    }
+    for (const auto &item : other) push_back(item);
+    return *this;
+  }
+
+  deque &operator=(deque &&other) noexcept(
+      allocator_traits::propagate_on_container_move_assignment::value ||
+      allocator_traits::is_always_equal::value) {
+    if (this == &other) return *this;
+    clear();
+    if (allocator_traits::propagate_on_container_move_assignment::value ||
+        _allocator == other._allocator) {
+      releaseStorage();
+      if (allocator_traits::propagate_on_container_move_assignment::value) {
+        _allocator = other._allocator;
+      }
+      swapStorage(other);
+    } else {
+      for (auto &item : other) push_back(std::move(item));
+      other.clear();
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept { return _allocator; }
+
+  reference at(size_type pos) {
+    if (pos >= _size) throw std::out_of_range("out_of_range");
+    return (*this)[pos];
+  }
+  const_reference at(size_type pos) const {
+    if (pos >= _size) throw std::out_of_range("out_of_range");
+    return (*this)[pos];
+  }
+
+  reference operator[](size_type pos) {
+    size_type i = _start + pos;
+    return _map[i / blockSize][i % blockSize];
+  }
+  const_reference operator[](size_type pos) const {
+    size_type i = _start + pos;
+    return _map[i / blockSize][i % blockSize];
+  }
+
+  reference front() { return (*this)[0]; }
+  const_reference front() const { return (*this)[0]; }
+  reference back() { return (*this)[_size - 1]; }
+  const_reference back() const { return (*this)[_size - 1]; }
+
+  iterator begin() noexcept { return at_index(_start); }
+  iterator end() noexcept { return at_index(_start + _size); }
+  const_iterator begin() const noexcept { return at_index(_start); }
+  const_iterator end() const noexcept { return at_index(_start + _size); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  bool empty() const noexcept { return _size == 0; }
+  size_type size() const noexcept { return _size; }
+  size_type max_size() const noexcept {
+    return allocator_traits::max_size(_allocator);
+  }
+
+  void clear() noexcept {
+    while (_size) pop_back();
+  }
+
+  // Frees the spare blocks and, for an empty deque, the map.
+  void shrink_to_fit() {
+    while (_spare_count) {
+      allocator_traits::deallocate(_allocator, _spare[--_spare_count],
+                                   blockSize);
+    }
+    if (_size == 0) releaseStorage();
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+  void push_front(const T &value) { emplace_front(value); }
+  void push_front(T &&value) { emplace_front(std::move(value)); }
+
+  template <class... Args>
+  reference emplace_back(Args &&...args) {
+    size_type block = (_start + _size) / blockSize;
+    if (block == _map_capacity) {
+      makeRoom();
+      block = (_start + _size) / blockSize;
+    }
+    bool fresh = !_map[block];
+    if (fresh) _map[block] = takeBlock();
+    try {
+      allocator_traits::construct(_allocator, &(*this)[_size],
+                                  std::forward<Args>(args)...);
+    } catch (...) {
+      if (fresh) returnBlock(block);
+      throw;
+    }
+    _size++;
+    return back();
+  }
+
+  template <class... Args>
+  reference emplace_front(Args &&...args) {
+    if (_start == 0) makeRoom();
+    size_type block = (_start - 1) / blockSize;
+    bool fresh = !_map[block];
+    if (fresh) _map[block] = takeBlock();
+    size_type i = _start - 1;
+    try {
+      allocator_traits::construct(_allocator, &_map[block][i % blockSize],
+                                  std::forward<Args>(args)...);
+    } catch (...) {
+      if (fresh) returnBlock(block);
+      throw;
+    }
+    _start--;
+    _size++;
+    return front();
+  }
+
+  void pop_back() {
+    allocator_traits::destroy(_allocator, &back());
+    _size--;
+    size_type i = _start + _size;
+    if (i % blockSize == 0 || _size == 0) returnBlock(i / blockSize);
+    if (_size == 0) recenter();
+  }
+
+  void pop_front() {
+    allocator_traits::destroy(_allocator, &front());
+    _start++;
+    _size--;
+    if (_start % blockSize == 0 || _size == 0) {
+      returnBlock((_start - 1) / blockSize);
+    }
+    if (_size == 0) recenter();
+  }
+
+  void resize(size_type count) {
+    while (_size > count) pop_back();
+    while (_size < count) emplace_back();
+  }
+
+  void resize(size_type count, const value_type &value) {
+    while (_size > count) pop_back();
+    while (_size < count) push_back(value);
+  }
+
+  void swap(deque &other) noexcept(
+      allocator_traits::propagate_on_container_swap::value ||
+      allocator_traits::is_always_equal::value) {
+    if (allocator_traits::propagate_on_container_swap::value) {
+      std::swap(_allocator, other._allocator);
+    }
+    swapStorage(other);
+  }
+
+ private:
+  static constexpr size_type minMapCapacity = 8;
+
+  iterator at_index(size_type i) const noexcept {
+    if (!_map) return iterator();
+    T **node = _map + i / blockSize;
+    return iterator(node, *node ? *node + i % blockSize : nullptr);
+  }
+
+  size_type usedBlocks() const {
+    if (_size == 0) return 0;
+    return (_start + _size - 1) / blockSize - _start / blockSize + 1;
+  }
+
+  // Gives the occupied blocks free map slots on both sides, moving the
+  // block pointers to the middle of the map and doubling it when it is
+  // more than half full. The elements stay where they are.
+  void makeRoom() {
+    size_type used = usedBlocks(), first = _start / blockSize;
+    size_type capacity = _map_capacity;
+    T **map = _map;
+    if (2 * (used + 1) > capacity) {
+      capacity = capacity ? capacity * 2 : minMapCapacity;
+      while (2 * (used + 1) > capacity) capacity *= 2;
+      map_allocator alloc(_allocator);
+      map = map_traits::allocate(alloc, capacity + 1);
+      for (size_type k = 0; k <= capacity; k++) map[k] = nullptr;
+    }
+    size_type target = (capacity - used) / 2;
+    if (map == _map) {
+      if (target < first) {
+        for (size_type k = 0; k < used; k++) {
+          std::swap(map[target + k], map[first + k]);
+        }
+      } else {
+        for (size_type k = used; k-- > 0;) {
+          std::swap(map[target + k], map[first + k]);
+        }
+      }
+    } else {
+      for (size_type k = 0; k < used; k++) map[target + k] = _map[first + k];
+      releaseMap();
+      _map = map;
+      _map_capacity = capacity;
+    }
+    _start = target * blockSize + _start % blockSize;
+  }
+
+  void recenter() { _start = _map_capacity / 2 * blockSize; }
+
+  T *takeBlock() {
+    if (_spare_count) return _spare[--_spare_count];
+    return allocator_traits::allocate(_allocator, blockSize);
+  }
+
+  void returnBlock(size_type block) noexcept {
+    if (_spare_count < spareBlocks) {
+      _spare[_spare_count++] = _map[block];
+    } else {
+      allocator_traits::deallocate(_allocator, _map[block], blockSize);
+    }
+    _map[block] = nullptr;
+  }
+
+  void releaseMap() noexcept {
+    if (!_map) return;
+    map_allocator alloc(_allocator);
+    map_traits::deallocate(alloc, _map, _map_capacity + 1);
+    _map = nullptr;
+    _map_capacity = 0;
+  }
+
+  // Only called on an empty deque.
+  void releaseStorage() noexcept {
+    while (_spare_count) {
+      allocator_traits::deallocate(_allocator, _spare[--_spare_count],
+                                   blockSize);
+    }
+    releaseMap();
+    _start = 0;
+  }
+
+  void swapStorage(deque &other) noexcept {
+    std::swap(_map, other._map);
+    std::swap(_map_capacity, other._map_capacity);
+    std::swap(_start, other._start);
+    std::swap(_size, other._size);
+    std::swap(_spare, other._spare);
+    std::swap(_spare_count, other._spare_count);
+  }
+
+  // _map holds _map_capacity block pointers plus a null one past the end,
+  // which end() points into when the last block is full.
+  T **_map = nullptr;
+  size_type _map_capacity = 0;
+  size_type _start = 0;
+  size_type _size = 0;
+  T *_spare[spareBlocks] = {};
+  size_type _spare_count = 0;
+  Allocator _allocator;
+};
+
+}  // namespace s21
+
+#endif  // S21_DEQUE_H_
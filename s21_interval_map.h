@@ -0,0 +1,182 @@
+#pragma once
+
+#include <stdexcept>
+
+#include "s21_tree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+template <class Key, class T>
+struct interval_entry {
+  interval_entry() : low(), high(), value(), max_high() {}
+  interval_entry(const Key &l, const Key &h, const T &v)
+      : low(l), high(h), value(v), max_high(h) {}
+
+  Key low;
+  Key high;
+  T value;
+
+ private:
+  template <class, class>
+  friend class interval_max_update;
+  template <class, class, class, class>
+  friend class interval_map;
+
+  // Largest high in the subtree of the node holding the entry.
+  Key max_high;
+};
+
+template <class value_type, class Compare>
+class interval_compare {
+ public:
+  interval_compare() : comp(Compare()) {}
+
+  bool operator()(const value_type &lhs, const value_type &rhs) {
+    if (comp(lhs.low, rhs.low)) return true;
+    if (comp(rhs.low, lhs.low)) return false;
+    return comp(lhs.high, rhs.high);
+  }
+
+ private:
+  Compare comp;
+};
+
+template <class value_type, class Compare>
+class interval_max_update {
+ public:
+  interval_max_update() : comp(Compare()) {}
+
+  template <class NodeT>
+  void operator()(NodeT *node, const NodeT *nil) {
+    auto &item = node->item;
+    item.max_high = item.high;
+    if (node->left != nil && comp(item.max_high, node->left->item.max_high)) {
+      item.max_high = node->left->item.max_high;
+    }
+    if (node->right != nil &&
+        comp(item.max_high, node->right->item.max_high)) {
+      item.max_high = node->right->item.max_high;
+    }
+  }
+
+ private:
+  Compare comp;
+};
+
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<interval_entry<Key, T>>>
+class interval_map {
+  using entry_compare = interval_compare<interval_entry<Key, T>, Compare>;
+  using entry_update = interval_max_update<interval_entry<Key, T>, Compare>;
+  using NodeT = ::Node<interval_entry<Key, T>, entry_compare>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = interval_entry<Key, T>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator =
+      CTree_iterator<value_type, entry_compare, Allocator, entry_update>;
+  using const_iterator =
+      const CTree_iterator<value_type, entry_compare, Allocator, entry_update>;
+  using size_type = size_t;
+
+  interval_map() {}
+  interval_map(const interval_map &m) {
+    for (auto it = m.cbegin(); it != m.cend(); it++) {
+      auto item = *it;
+      insert(item.low, item.high, item.value);
+    }
+  }
+  interval_map(interval_map &&m) noexcept {
+    if (this != &m) {
+      std::swap(tree, m.tree);
+    }
+  }
+  ~interval_map() {}
+  interval_map &operator=(interval_map &&m) {
+    if (this == &m) return *this;
+    std::swap(tree, m.tree);
+    return *this;
+  }
+
+  iterator begin() { return iterator(tree, tree.getFirstNode()); }
+  iterator end() { return iterator(tree, tree.getSentinelNode()); }
+
+  const_iterator cbegin() const {
+    return const_iterator(tree, tree.getFirstNode());
+  }
+  const_iterator cend() const {
+    return const_iterator(tree, tree.getSentinelNode());
+  }
+
+  bool empty() { return tree.getNumberOfNodes() == 0; }
+  size_type size() { return tree.getNumberOfNodes(); }
+  size_type max_size() { return std::numeric_limits<size_type>::max(); }
+
+  void clear() { tree.removeAllNodes(); }
+
+  std::pair<iterator, bool> insert(const Key &low, const Key &high,
+                                   const T &obj) {
+    if (!comp(low, high)) {
+      throw std::invalid_argument("invalid_interval");
+    }
+    value_type value(low, high, obj);
+    auto node = tree.findNode(value);
+    if (!tree.isNil(node)) {
+      return std::pair<iterator, bool>{iterator(tree, node), false};
+    } else {
+      return std::pair<iterator, bool>{iterator(tree, tree.insertNode(value)),
+                                       true};
+    }
+  }
+
+  void erase(iterator pos) { tree.removeNode(*pos); }
+  void swap(interval_map &other) { std::swap(*this, other); }
+
+  iterator find(const Key &low, const Key &high) {
+    return iterator(tree, tree.findNode(value_type(low, high, T())));
+  }
+
+  s21::vector<iterator> find_containing(const Key &point) {
+    s21::vector<iterator> out;
+    collectOverlapping(tree.getRootNode(), point, point, true, out);
+    return out;
+  }
+
+  s21::vector<iterator> find_overlapping(const Key &low, const Key &high) {
+    s21::vector<iterator> out;
+    if (comp(low, high)) {
+      collectOverlapping(tree.getRootNode(), low, high, false, out);
+    }
+    return out;
+  }
+
+ private:
+  // Visits [low, high) in key order; a point query is the closed range
+  // [point, point], since a half-open interval containing it must start at or
+  // before it.
+  void collectOverlapping(NodeT *node, const Key &low, const Key &high,
+                          bool point, s21::vector<iterator> &out) {
+    if (tree.isNil(node) || !comp(low, node->item.max_high)) {
+      return;
+    }
+    collectOverlapping(node->left, low, high, point, out);
+    bool starts_before_end = point ? !comp(high, node->item.low)
+                                   : comp(node->item.low, high);
+    if (!starts_before_end) {
+      return;
+    }
+    if (comp(low, node->item.high)) {
+      out.push_back(iterator(tree, node));
+    }
+    collectOverlapping(node->right, low, high, point, out);
+  }
+
+  Compare comp;
+  CTree<value_type, entry_compare, Allocator, entry_update> tree;
+};
+
+};  // namespace s21
@@ -0,0 +1,247 @@
+#ifndef _SRC_S21_INTRUSIVE_LIST_H_
+#define _SRC_S21_INTRUSIVE_LIST_H_
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "s21_list.h"
+
+namespace s21 {
+
+// Embedded in the objects an intrusive_list links together. Copying an
+// object does not copy its membership: the copy starts unlinked.
+class intrusive_list_hook : public NodeLinks {
+ public:
+  intrusive_list_hook() {}
+  intrusive_list_hook(const intrusive_list_hook &) : NodeLinks() {}
+  intrusive_list_hook &operator=(const intrusive_list_hook &) { return *this; }
+
+  bool is_linked() const { return next != nullptr; }
+};
+
+// A list of objects that live elsewhere, linked through their Hook member.
+// The list never allocates, copies or destroys the objects; an object can be
+// in as many lists at once as it has hooks, and must outlive its membership.
+// Hook must not belong to a virtual base of T, since the object is found
+// from its hook at a fixed offset.
+template <class T, intrusive_list_hook T::*Hook>
+class intrusive_list {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+ private:
+  template <bool IsConst>
+  class common_iterator {
+    friend intrusive_list;
+
+   public:
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+
+    common_iterator(NodeLinks *node) : ptr(node) {}
+
+    operator common_iterator<true>() const {
+      return common_iterator<true>(ptr);
+    }
+
+    reference operator*() const { return *owner(ptr); }
+    std::conditional_t<IsConst, const T *, T *> operator->() const {
+      return owner(ptr);
+    }
+
+    common_iterator &operator++() {
+      ptr = ptr->next;
+      return *this;
+    }
+
+    common_iterator &operator--() {
+      ptr = ptr->prev;
+      return *this;
+    }
+
+    common_iterator operator++(int) {
+      auto iter = *this;
+      ++(*this);
+      return iter;
+    }
+
+    common_iterator operator--(int) {
+      auto iter = *this;
+      --(*this);
+      return iter;
+    }
+
+    bool operator==(const common_iterator &other) const {
+      return ptr == other.ptr;
+    }
+    bool operator!=(const common_iterator &other) const {
+      return ptr != other.ptr;
+    }
+
+   private:
+    NodeLinks *ptr;
+  };
+
+ public:
+  using iterator = common_iterator<false>;
+  using const_iterator = common_iterator<true>;
+
+  intrusive_list() noexcept : sentinel{&sentinel, &sentinel} {}
+  intrusive_list(const intrusive_list &) = delete;
+  intrusive_list &operator=(const intrusive_list &) = delete;
+
+  intrusive_list(intrusive_list &&other) noexcept : intrusive_list() {
+    swap(other);
+  }
+
+  intrusive_list &operator=(intrusive_list &&other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  ~intrusive_list() { clear(); }
+
+  iterator begin() { return iterator(sentinel.next); }
+  iterator end() { return iterator(&sentinel); }
+  const_iterator begin() const { return const_iterator(sentinel.next); }
+  const_iterator end() const {
+    return const_iterator(const_cast<NodeLinks *>(&sentinel));
+  }
+
+  reference front() { return *owner(sentinel.next); }
+  reference back() { return *owner(sentinel.prev); }
+  const_reference front() const { return *owner(sentinel.next); }
+  const_reference back() const { return *owner(sentinel.prev); }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type max_size() const {
+    return std::numeric_limits<std::ptrdiff_t>().max() / sizeof(T);
+  }
+
+  // Unlinks every object; the objects themselves are left alone.
+  void clear() noexcept {
+    for (NodeLinks *i = sentinel.next; i != &sentinel;) {
+      NodeLinks *next = i->next;
+      i->prev = i->next = nullptr;
+      i = next;
+    }
+    sentinel.next = sentinel.prev = &sentinel;
+    size_ = 0;
+  }
+
+  void push_back(T &item) { insert(end(), item); }
+  void push_front(T &item) { insert(begin(), item); }
+  void pop_back() { erase(iterator(sentinel.prev)); }
+  void pop_front() { erase(iterator(sentinel.next)); }
+
+  // item must not be linked through Hook already.
+  iterator insert(const_iterator pos, T &item) {
+    hookOffset(&item);
+    NodeLinks *links = &(item.*Hook);
+    links->next = pos.ptr;
+    links->prev = pos.ptr->prev;
+    pos.ptr->prev->next = links;
+    pos.ptr->prev = links;
+    size_++;
+    return iterator(links);
+  }
+
+  // Returns the iterator to the object after the unlinked one.
+  iterator erase(const_iterator pos) {
+    NodeLinks *links = pos.ptr, *next = links->next;
+    links->prev->next = next;
+    next->prev = links->prev;
+    links->prev = links->next = nullptr;
+    size_--;
+    return iterator(next);
+  }
+
+  // Unlinks item, which must be in this list, without walking to it.
+  void erase(T &item) { erase(iterator_to(item)); }
+
+  iterator iterator_to(T &item) { return iterator(&(item.*Hook)); }
+  const_iterator iterator_to(const T &item) const {
+    return const_iterator(const_cast<intrusive_list_hook *>(&(item.*Hook)));
+  }
+
+  // Moves every object of other in front of pos in O(1).
+  void splice(const_iterator pos, intrusive_list &other) {
+    if (this == &other || other.empty()) return;
+    NodeLinks *first = other.sentinel.next, *last = other.sentinel.prev;
+    first->prev = pos.ptr->prev;
+    pos.ptr->prev->next = first;
+    last->next = pos.ptr;
+    pos.ptr->prev = last;
+    size_ += other.size_;
+    other.sentinel.next = other.sentinel.prev = &other.sentinel;
+    other.size_ = 0;
+  }
+
+  // Moves the single object at it, which may belong to other, before pos.
+  void splice(const_iterator pos, intrusive_list &other, const_iterator it) {
+    if (pos.ptr == it.ptr || pos.ptr == it.ptr->next) return;
+    T &moved = *owner(it.ptr);
+    other.erase(it);
+    insert(pos, moved);
+  }
+
+  void reverse() {
+    NodeLinks *links = &sentinel;
+    do {
+      NodeLinks *next = links->next;
+      links->next = links->prev;
+      links->prev = next;
+      links = next;
+    } while (links != &sentinel);
+  }
+
+  void swap(intrusive_list &other) {
+    std::swap(sentinel.next, other.sentinel.next);
+    std::swap(sentinel.prev, other.sentinel.prev);
+    std::swap(size_, other.size_);
+    repairSentinel();
+    other.repairSentinel();
+  }
+
+ private:
+  // The distance from an object to its hook, measured once on the first
+  // object linked into any list of this type. Only linked objects are ever
+  // recovered from their hooks, so by then it is known.
+  static std::ptrdiff_t hookOffset(const T *item = nullptr) {
+    static const std::ptrdiff_t offset =
+        reinterpret_cast<const unsigned char *>(&(item->*Hook)) -
+        reinterpret_cast<const unsigned char *>(item);
+    return offset;
+  }
+
+  // Recovers the object from the address of its hook.
+  static T *owner(NodeLinks *links) {
+    auto *hook = static_cast<intrusive_list_hook *>(links);
+    return reinterpret_cast<T *>(reinterpret_cast<unsigned char *>(hook) -
+                                 hookOffset());
+  }
+
+  void repairSentinel() {
+    if (size_ == 0) {
+      sentinel.next = sentinel.prev = &sentinel;
+    } else {
+      sentinel.next->prev = &sentinel;
+      sentinel.prev->next = &sentinel;
+    }
+  }
+
+  NodeLinks sentinel;
+  size_type size_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // _SRC_S21_INTRUSIVE_LIST_H_
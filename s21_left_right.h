@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Numbers the threads that read, handing the number of an exited thread to
+// the next new one, so the live threads always hold the lowest numbers.
+inline size_t left_right_slot() {
+  struct Registry {
+    std::mutex lock;
+    size_t next = 0;
+    s21::vector<size_t> released;
+  };
+  static Registry registry;
+  struct Slot {
+    Slot() {
+      std::lock_guard<std::mutex> guard(registry.lock);
+      if (registry.released.empty()) {
+        id = registry.next++;
+      } else {
+        id = registry.released.back();
+        registry.released.pop_back();
+      }
+    }
+    ~Slot() {
+      std::lock_guard<std::mutex> guard(registry.lock);
+      registry.released.push_back(id);
+    }
+    size_t id;
+  };
+  thread_local Slot slot;
+  return slot.id;
+}
+
+// Keeps two copies of the container. Readers use the copy writers are not
+// touching and only announce themselves in their own cache line, so a read
+// never waits and, with at most readSlots threads alive, never writes to a
+// line other threads read; further threads share lines, which only costs
+// contention. A writer applies its operation to the idle copy, swaps the
+// copies, waits for the readers of the old one to leave, and replays the
+// operation on it.
+//
+// Operations must be deterministic, since each one runs once per copy. If
+// one throws on the idle copy, that copy is rebuilt from the other and the
+// write has no effect; if the replay throws, the write is already visible
+// and the replayed copy is rebuilt from the published one. Either way the
+// exception then propagates.
+// Readers get a mutable reference because the lookups of s21 containers are
+// not const; they must only look up, and finger search must stay off.
+template <class Container>
+class left_right {
+ public:
+  static constexpr size_t readSlots = 64;
+
+  left_right() {}
+  explicit left_right(const Container &c) : copies{c, c} {}
+  left_right(const left_right &) = delete;
+  left_right &operator=(const left_right &) = delete;
+
+  template <class Read>
+  auto read(Read fn) {
+    auto &slot = readers[version.load()][left_right_slot() % readSlots];
+    slot.count.fetch_add(1);
+    struct Depart {
+      std::atomic<size_t> &count;
+      ~Depart() { count.fetch_sub(1); }
+    } depart{slot.count};
+    return fn(copies[active.load()]);
+  }
+
+  template <class Write>
+  auto write(Write fn) {
+    std::lock_guard<std::mutex> lock(writer);
+    auto idle = 1 - active.load();
+    apply(fn, idle);
+    active.store(idle);
+
+    auto previous = version.load(), next = 1 - previous;
+    waitForReaders(next);
+    version.store(next);
+    waitForReaders(previous);
+    return apply(fn, 1 - idle);
+  }
+
+ private:
+  struct alignas(64) ReadSlot {
+    std::atomic<size_t> count{0};
+  };
+
+  template <class Write>
+  auto apply(Write &fn, size_t index) {
+    try {
+      return fn(copies[index]);
+    } catch (...) {
+      copies[index] = Container(copies[1 - index]);
+      throw;
+    }
+  }
+
+  void waitForReaders(size_t index) {
+    for (auto &slot : readers[index]) {
+      while (slot.count.load() != 0) std::this_thread::yield();
+    }
+  }
+
+  Container copies[2];
+  ReadSlot readers[2][readSlots];
+  alignas(64) std::atomic<size_t> active{0};
+  std::atomic<size_t> version{0};
+  std::mutex writer;
+};
+
+}  // namespace s21
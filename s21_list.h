@@ -1,28 +1,37 @@
 #ifndef _SRC_S21_LIST_H_
 #define _SRC_S21_LIST_H_
 
+#include <functional>
 #include <initializer_list>
 #include <limits>
+#include <memory>
+#include <utility>
 
 namespace s21 {
 
+class NodeLinks {
+ public:
+  NodeLinks *prev = nullptr, *next = nullptr;
+};
+
 template <class T>
-class Node {
+class Node : public NodeLinks {
  public:
   T value;
-  Node<T> *prev = nullptr, *next = nullptr;
-  Node(const T val) : value(val) {}
+
+  template <class... Args>
+  explicit Node(Args &&...args) : value(std::forward<Args>(args)...) {}
 };
 
-template <class T>
+template <class T, class Allocator = std::allocator<T>>
 class list {
  public:
   class ListIterator {
     friend list;
 
    public:
-    ListIterator(Node<T> *node) : ptr(node){};
-    T &operator*() { return ptr->value; }
+    ListIterator(NodeLinks *node) : ptr(node){};
+    T &operator*() { return static_cast<Node<T> *>(ptr)->value; }
     ListIterator operator++(int) {
       ptr = ptr->next;
       return *this;
@@ -43,7 +52,7 @@ class list {
     bool operator==(const ListIterator &other) { return ptr == other.ptr; }
 
    protected:
-    Node<T> *ptr = nullptr;
+    NodeLinks *ptr = nullptr;
   };
 
   class ListConstIterator : ListIterator {
@@ -53,12 +62,15 @@ class list {
     const T &operator*() { return ListIterator::operator*(); }
     ListConstIterator(ListIterator other) : ListIterator(other) {}
     ListConstIterator operator++(int) {
-      ptr = ptr->next;
+      ListIterator::operator++();
       return *this;
     }
-
-   protected:
-    Node<T> *ptr = nullptr;
+    bool operator!=(const ListConstIterator &other) {
+      return ListIterator::operator!=(other);
+    }
+    bool operator==(const ListConstIterator &other) {
+      return ListIterator::operator==(other);
+    }
   };
 
   using value_type = T;
@@ -67,312 +79,463 @@ class list {
   using iterator = ListIterator;
   using const_iterator = ListConstIterator;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
 
  private:
   using NodeT = Node<value_type>;
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<NodeT>;
+  using node_traits = std::allocator_traits<node_allocator>;
 
  public:
-  const_reference front() const { return head->value; }
-  const_reference back() const { return tail->value; }
-
-  iterator begin() { return iterator(head); }
-  iterator end() { return iterator(not_a_node); }
-
-  const_iterator begin() const { return const_iterator(head); }
-  const_iterator end() const { return const_iterator(not_a_node); }
-
-  void pop_front() { pop(head); }
-  void pop_back() { pop(tail); }
-  list() {
-    not_a_node = new NodeT(value_type{});
-    head = tail = not_a_node;
-    head->next = head;
-    head->prev = head;
-  };
+  reference front() { return node(not_a_node.next)->value; }
+  reference back() { return node(not_a_node.prev)->value; }
+  const_reference front() const { return node(not_a_node.next)->value; }
+  const_reference back() const { return node(not_a_node.prev)->value; }
+
+  iterator begin() { return iterator(not_a_node.next); }
+  iterator end() { return iterator(&not_a_node); }
 
-  list(size_type n) {
-    not_a_node = new NodeT(value_type{});
-    for (size_type k = 0; k < n; k++) push_back(0);
+  const_iterator begin() const { return const_iterator(not_a_node.next); }
+  const_iterator end() const {
+    return const_iterator(const_cast<NodeLinks *>(&not_a_node));
   }
 
-  list(std::initializer_list<value_type> const &items) {
-    not_a_node = new NodeT(value_type{});
+  void pop_front() { pop(node(not_a_node.next)); }
+  void pop_back() { pop(node(not_a_node.prev)); }
+
+  // The sentinel lives inside the list, so an empty list owns no memory.
+  list() noexcept(noexcept(Allocator())) : list(Allocator()) {}
+
+  explicit list(const Allocator &alloc) noexcept
+      : not_a_node{&not_a_node, &not_a_node}, allocator_(alloc) {}
+
+  list(size_type n, const Allocator &alloc = Allocator()) : list(alloc) {
+    for (size_type k = 0; k < n; k++) emplace_back(value_type{});
+  }
+
+  list(std::initializer_list<value_type> const &items,
+       const Allocator &alloc = Allocator())
+      : list(alloc) {
     for (const auto &add : items) push_back(add);
   }
 
-  list(const list &other) : list() {
-    NodeT *tmp = other.head;
-    for (std::size_t i = 0; i < other.size_; i++) {
-      this->push_back(tmp->value);
-      tmp = tmp->next;
+  list(const list &other)
+      : list(other,
+             Allocator(node_traits::select_on_container_copy_construction(
+                 other.allocator_))) {}
+
+  list(const list &other, const Allocator &alloc) : list(alloc) {
+    for (NodeLinks *i = other.not_a_node.next; i != &other.not_a_node;
+         i = i->next) {
+      push_back(node(i)->value);
     }
   }
 
-  list(list<value_type> &&l) {
-    not_a_node = l.not_a_node;
-    head = l.head;
-    tail = l.tail;
-    size_ = l.size_;
-    l.not_a_node = l.head = l.tail = nullptr;
-    l.size_ = 0;
-  }
+  list(list &&l) noexcept : list(Allocator(l.allocator_)) { take(l); }
 
-  list &operator=(list<value_type> &&l) {
+  list &operator=(list &&l) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value) {
+    if (this == &l) return *this;
     clear();
-    delete not_a_node;
-    not_a_node = l.not_a_node;
-    size_ = l.size_;
-    head = l.head;
-    tail = l.tail;
-    l.not_a_node = l.head = l.tail = nullptr;
-    l.size_ = 0;
+    if (node_traits::propagate_on_container_move_assignment::value) {
+      allocator_ = l.allocator_;
+    }
+    if (allocator_ == l.allocator_) {
+      take(l);
+    } else {
+      for (NodeLinks *i = l.not_a_node.next; i != &l.not_a_node; i = i->next) {
+        emplace_back(std::move(node(i)->value));
+      }
+      l.clear();
+    }
     return *this;
   }
 
-  list &operator=(const list<value_type> &l) {
-    if (size() > l.size()) {
-      while (size() != l.size()) {
-        pop_back();
-      }
-    } else {
-      while (size() != l.size()) {
-        push_back(0);
+  list &operator=(const list &l) {
+    if (this != &l) {
+      if (node_traits::propagate_on_container_copy_assignment::value &&
+          allocator_ != l.allocator_) {
+        clear();
+        allocator_ = l.allocator_;
       }
+      list copy(l, get_allocator());
+      swap(copy);
     }
-
-    iterator it = begin();
-    for (auto i : l) *it = i->value;
     return *this;
   }
 
-  ~list() {
-    clear();
-    delete not_a_node;
-  };
+  allocator_type get_allocator() const { return allocator_type(allocator_); }
 
-  void push_back(const value_type &value) {
-    NodeT *node = new Node(value);
-    if (size_ == 0) {
-      head = tail = node;
-      tail->next = not_a_node;
-      head->prev = not_a_node;
-      not_a_node->prev = tail;
-      not_a_node->next = head;
-    } else {
-      NodeT *tmp = head;
-      tmp = tail;
-      tmp->next = tail = node;
-      tail->next = not_a_node;
-      tail->prev = tmp;
-      head->prev = not_a_node;
-      not_a_node->prev = tail;
-      not_a_node->next = head;
-    }
-    size_++;
-    not_a_node->value = size_;
-  }
+  ~list() { clear(); };
 
-  void push_front(const value_type &value) {
-    NodeT *node = new Node(value);
-    if (size_ == 0) {
-      head = tail = node;
-      tail->next = not_a_node;
-      head->prev = not_a_node;
-      not_a_node->prev = tail;
-      not_a_node->next = head;
-    } else {
-      NodeT *tmp = head;
-      head = node;
-      head->next = tmp;
-      tmp->prev = head;
-      head->prev = not_a_node;
-      not_a_node->next = head;
-      not_a_node->prev = tail;
-      tail->next = not_a_node;
-    }
-    size_++;
-    not_a_node->value = size_;
-  }
+  void push_back(const value_type &value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  void push_front(const value_type &value) { emplace_front(value); }
+  void push_front(value_type &&value) { emplace_front(std::move(value)); }
 
   void pop(NodeT *del) {
     if (size_ < 1) return;
-    if (size_ == 1) {
-      head = tail = not_a_node;
-      not_a_node->next = not_a_node;
-      not_a_node->prev = not_a_node;
-    } else if (size_ == 2) {
-      if (del == head) {
-        head = tail;
-        head->prev = not_a_node;
-        not_a_node->next = head;
-      } else {
-        tail = head;
-        tail->next = not_a_node;
-        not_a_node->prev = tail;
-      }
-    } else if (del == head) {
-      head = head->next;
-      head->prev = not_a_node;
-      not_a_node->next = head;
-    } else if (del == tail) {
-      tail = tail->prev;
-      tail->next = not_a_node;
-      not_a_node->prev = tail;
-    } else {
-      NodeT *n2 = del->next;
-      NodeT *n1 = del->prev;
-      n2->prev = n1;
-      n1->next = n2;
-    }
-    delete del;
+    del->prev->next = del->next;
+    del->next->prev = del->prev;
+    destroyNode(del);
     size_--;
-    not_a_node->value = size_;
   }
 
-  size_type size() { return size_; }
+  size_type size() const { return size_; }
 
-  void swap(list<value_type> &other) {
-    swap<NodeT *>(&head, &other.head);
-    swap<NodeT *>(&tail, &other.tail);
-    swap<NodeT *>(&not_a_node, &other.not_a_node);
+  void swap(list &other) {
+    if (node_traits::propagate_on_container_swap::value) {
+      std::swap(allocator_, other.allocator_);
+    }
+    swap<NodeLinks *>(&not_a_node.next, &other.not_a_node.next);
+    swap<NodeLinks *>(&not_a_node.prev, &other.not_a_node.prev);
     swap<size_type>(&size_, &other.size_);
+    swap<size_type>(&loose_, &other.loose_);
+    swap<Block *>(&blocks_, &other.blocks_);
+    repairSentinel();
+    other.repairSentinel();
   }
 
-  bool operator==(list<value_type> other) const {
+  bool operator==(const list &other) const {
     if (size_ != other.size_) {
       return false;
     }
-    for (NodeT *i = head, *j = other.head; i != not_a_node;
-         i = i->next, j = j->next) {
-      if (i->value != j->value) return false;
+    for (NodeLinks *i = not_a_node.next, *j = other.not_a_node.next;
+         i != &not_a_node; i = i->next, j = j->next) {
+      if (node(i)->value != node(j)->value) return false;
     }
     return true;
   }
 
   bool empty() const { return size_ == 0 ? true : false; }
   size_type max_size() const {
-    return std::numeric_limits<std::ptrdiff_t>().max() / sizeof(NodeT);
+    return node_traits::max_size(allocator_);
   }
 
-  void clear() {
-    while (head != not_a_node) {
-      NodeT *remove = head;
-      head = head->next;
-      delete remove;
+  void clear() noexcept {
+    for (NodeLinks *i = not_a_node.next; i != &not_a_node;) {
+      NodeLinks *remove = i;
+      i = i->next;
+      destroyNode(node(remove));
     }
+    not_a_node.next = not_a_node.prev = &not_a_node;
     size_ = 0;
   }
 
-  iterator insert(iterator pos, value_type value) {
-    auto node = new Node(value);
-    auto left = pos.ptr->prev;
-    auto right = pos.ptr;
-    node->next = right;
-    node->prev = left;
-    left->next = node;
-    right->prev = node;
-    size_++;
-    not_a_node->value = size_;
-    return iterator(node);
+  iterator insert(iterator pos, const value_type &value) {
+    return emplace(pos, value);
+  }
+
+  iterator insert(iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
   }
 
-  void erase(iterator pos) { pop(pos.ptr); }
+  void erase(iterator pos) { pop(node(pos.ptr)); }
 
   void splice(const_iterator pos, list &other) {
+    if (other.size_ == 0) return;
     iterator it = pos;
-    NodeT *left = it.ptr->prev;
-    NodeT *right = it.ptr;
-
-    left->next = other.head;
-    other.head->prev = left;
-    right->prev = other.tail;
-    other.tail->next = right;
-    size_ += other.size_;
-    not_a_node->value = size_;
-    other.size_ = 0;
-    other.head = other.tail = other.not_a_node;
-    other.not_a_node->next = other.not_a_node;
-    other.not_a_node->prev = other.not_a_node;
+    NodeLinks *left = it.ptr->prev;
+    NodeLinks *right = it.ptr;
+
+    left->next = other.not_a_node.next;
+    other.not_a_node.next->prev = left;
+    right->prev = other.not_a_node.prev;
+    other.not_a_node.prev->next = right;
+    adoptNodes(other);
   }
 
-  void merge(list &other) {
-    NodeT *tmp = other.head;
-    while (tmp != other.not_a_node) {
-      push_back(tmp->value);
-      tmp = tmp->next;
-    }
-    other.clear();
+  void merge(list &other) { merge(other, std::less<value_type>()); }
+
+  // Splices the nodes of other into place; on ties the nodes of *this stay
+  // in front.
+  template <class Compare>
+  void merge(list &other, Compare comp) {
+    if (this == &other || other.size_ == 0) return;
+    other.not_a_node.prev->next = nullptr;
+    NodeLinks *theirs = other.not_a_node.next;
+    NodeLinks *ours = size_ ? not_a_node.next : nullptr;
+    if (ours) not_a_node.prev->next = nullptr;
+    relink(mergeRuns(ours, theirs, comp));
+    adoptNodes(other);
   }
 
   void reverse() {
-    NodeT *this_ = head;
-    swap<NodeT *>(&head, &tail);
-    for (int k = 0; k <= (int)size_; k++) {
-      swap<NodeT *>(&this_->next, &this_->prev);
+    NodeLinks *this_ = &not_a_node;
+    for (size_type k = 0; k <= size_; k++) {
+      swap<NodeLinks *>(&this_->next, &this_->prev);
       this_ = this_->prev;
     }
   }
   void unique() {
-    NodeT *tmp = head;
-    while (tmp != not_a_node) {
-      const_reference val = tmp->value;
+    NodeLinks *tmp = not_a_node.next;
+    while (tmp != &not_a_node) {
+      const_reference val = node(tmp)->value;
       tmp = tmp->next;
-      while (tmp != not_a_node && val == tmp->value) {
-        NodeT *tmp2 = tmp->next;
-        pop(tmp);
+      while (tmp != &not_a_node && val == node(tmp)->value) {
+        NodeLinks *tmp2 = tmp->next;
+        pop(node(tmp));
         tmp = tmp2;
       }
     }
   }
-  void sort() {
-    NodeT *tmp = head;
-    bool flag = 0;
-
-    while (true) {
-      while (tmp->next != not_a_node) {
-        if (tmp->value > tmp->next->value) {
-          swap(&(tmp->value), &(tmp->next->value));
-          flag = 1;
-        } else {
-          tmp = tmp->next;
-        }
-      }
-      tmp = head;
 
-      if (!flag) {
-        break;
+  // Moves every element into one freshly allocated array of nodes, in list
+  // order, so that a traversal walks memory sequentially. Invalidates all
+  // iterators; the blocks of earlier compactions are freed as they empty.
+  void compact() {
+    if (size_ == 0) return;
+    block_allocator blocks(allocator_);
+    Block *block = block_traits::allocate(blocks, 1);
+    NodeT *nodes;
+    try {
+      nodes = node_traits::allocate(allocator_, size_);
+    } catch (...) {
+      block_traits::deallocate(blocks, block, 1);
+      throw;
+    }
+    size_type built = 0;
+    try {
+      for (NodeLinks *i = not_a_node.next; i != &not_a_node; i = i->next) {
+        node_traits::construct(allocator_, nodes + built,
+                               std::move_if_noexcept(node(i)->value));
+        built++;
       }
-      flag = false;
+    } catch (...) {
+      while (built) node_traits::destroy(allocator_, nodes + --built);
+      node_traits::deallocate(allocator_, nodes, size_);
+      block_traits::deallocate(blocks, block, 1);
+      throw;
     }
+    for (NodeLinks *i = not_a_node.next; i != &not_a_node;) {
+      NodeLinks *old = i;
+      i = i->next;
+      destroyNode(node(old));
+    }
+    block_traits::construct(blocks, block, Block{nodes, size_, size_, blocks_});
+    blocks_ = block;
+    NodeLinks *prev = &not_a_node;
+    for (size_type k = 0; k < size_; k++) {
+      nodes[k].prev = prev;
+      prev->next = nodes + k;
+      prev = nodes + k;
+    }
+    prev->next = &not_a_node;
+    not_a_node.prev = prev;
   }
 
-  iterator emplace(iterator pos, value_type arg) { return insert(pos, arg); }
+  // With a positive fraction, push_back, push_front and their emplace forms
+  // compact() the list after linking the new elements once more than that
+  // fraction of its nodes (of at least compactMinimum) were allocated one by
+  // one. Those calls then invalidate iterators and references to elements.
+  // Zero, the default, turns this off.
+  void set_auto_compact(double fraction) { compactFraction = fraction; }
+
+  void sort() { sort(std::less<value_type>()); }
+
+  // Bottom-up merge sort on the nodes themselves: bins[i] holds a sorted run
+  // of 2^i nodes, and every new node is carried up like a binary increment.
+  // Runs in lower bins hold later nodes, so ties keep their order.
+  template <class Compare>
+  void sort(Compare comp) {
+    if (size_ < 2) return;
+    NodeLinks *bins[std::numeric_limits<size_type>::digits] = {};
+    size_type used = 0;
+    not_a_node.prev->next = nullptr;
+    for (NodeLinks *i = not_a_node.next; i;) {
+      NodeLinks *run = i;
+      i = i->next;
+      run->next = nullptr;
+      size_type k = 0;
+      for (; k < used && bins[k]; k++) {
+        run = mergeRuns(bins[k], run, comp);
+        bins[k] = nullptr;
+      }
+      if (k == used) used++;
+      bins[k] = run;
+    }
+    NodeLinks *sorted = nullptr;
+    for (size_type k = 0; k < used; k++) {
+      if (bins[k]) sorted = sorted ? mergeRuns(bins[k], sorted, comp) : bins[k];
+    }
+    relink(sorted);
+  }
 
+  // Each argument becomes one element, constructed from it inside its node.
+  // Returns the iterator to the last element inserted, or pos if none was.
   template <class... Args>
-  iterator emplace(const_iterator pos, value_type first, Args &&...args) {
-    return emplace(insert(pos, first)++, args...);
+  iterator emplace(const_iterator pos, Args &&...args) {
+    iterator at = pos;
+    NodeLinks *last = at.ptr;
+    ((last = linkBefore(at.ptr, newNode(std::forward<Args>(args)))), ...);
+    return iterator(last);
   }
 
-  void emplace_back(value_type first) { push_back(first); }
-
   template <class... Args>
-  void emplace_back(value_type first, Args &&...args) {
-    push_back(first);
-    emplace_back(args...);
+  void emplace_back(Args &&...args) {
+    (linkBefore(&not_a_node, newNode(std::forward<Args>(args))), ...);
+    compactIfScattered();
   }
 
-  void emplace_front(value_type first) { push_front(first); }
-
   template <class... Args>
-  void emplace_front(value_type first, Args &&...args) {
-    push_front(first);
-    emplace_front(args...);
+  void emplace_front(Args &&...args) {
+    (linkBefore(not_a_node.next, newNode(std::forward<Args>(args))), ...);
+    compactIfScattered();
   }
 
  private:
   friend ListIterator;
-  NodeT *not_a_node = nullptr, *head = nullptr, *tail = nullptr;
+  // An array of nodes laid out by compact(). It is freed once the last of
+  // its nodes is destroyed, whichever list the node has been spliced into.
+  struct Block {
+    NodeT *nodes;
+    size_type capacity;
+    size_type live;
+    Block *next;
+
+    bool owns(const NodeT *item) const {
+      std::less<const NodeT *> less;
+      return !less(item, nodes) && less(item, nodes + capacity);
+    }
+  };
+
+  using block_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+  using block_traits = std::allocator_traits<block_allocator>;
+
+  static constexpr size_type compactMinimum = 64;
+
+  NodeLinks not_a_node;
   size_type size_ = 0;
+  // Nodes allocated one by one rather than in a block.
+  size_type loose_ = 0;
+  Block *blocks_ = nullptr;
+  double compactFraction = 0;
+  node_allocator allocator_;
+
+  template <class... Args>
+  NodeT *newNode(Args &&...args) {
+    NodeT *added = node_traits::allocate(allocator_, 1);
+    try {
+      node_traits::construct(allocator_, added, std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(allocator_, added, 1);
+      throw;
+    }
+    loose_++;
+    return added;
+  }
+
+  void destroyNode(NodeT *del) noexcept {
+    node_traits::destroy(allocator_, del);
+    for (Block **link = &blocks_; *link; link = &(*link)->next) {
+      Block *block = *link;
+      if (!block->owns(del)) continue;
+      if (--block->live == 0) {
+        *link = block->next;
+        freeBlock(block);
+      }
+      return;
+    }
+    node_traits::deallocate(allocator_, del, 1);
+    loose_--;
+  }
+
+  void freeBlock(Block *block) noexcept {
+    node_traits::deallocate(allocator_, block->nodes, block->capacity);
+    block_allocator blocks(allocator_);
+    block_traits::deallocate(blocks, block, 1);
+  }
+
+  void compactIfScattered() {
+    if (compactFraction > 0 && size_ >= compactMinimum &&
+        loose_ > compactFraction * size_) {
+      compact();
+    }
+  }
+
+  // Takes over the nodes of other, which have all been linked into this
+  // list already, together with the blocks they live in.
+  void adoptNodes(list &other) noexcept {
+    Block **tail = &blocks_;
+    while (*tail) tail = &(*tail)->next;
+    *tail = other.blocks_;
+    size_ += other.size_;
+    loose_ += other.loose_;
+    other.blocks_ = nullptr;
+    other.size_ = other.loose_ = 0;
+    other.not_a_node.next = other.not_a_node.prev = &other.not_a_node;
+  }
+
+  static NodeT *node(NodeLinks *links) { return static_cast<NodeT *>(links); }
+  static const NodeT *node(const NodeLinks *links) {
+    return static_cast<const NodeT *>(links);
+  }
+
+  NodeLinks *linkBefore(NodeLinks *pos, NodeT *added) {
+    added->next = pos;
+    added->prev = pos->prev;
+    pos->prev->next = added;
+    pos->prev = added;
+    size_++;
+    return added;
+  }
+
+  // Adopts the nodes of l, which is left empty; only the two nodes next to
+  // the sentinel need to learn its new address.
+  void take(list &l) noexcept {
+    if (l.size_ == 0) return;
+    not_a_node = l.not_a_node;
+    size_ = l.size_;
+    loose_ = l.loose_;
+    blocks_ = l.blocks_;
+    repairSentinel();
+    l.not_a_node.next = l.not_a_node.prev = &l.not_a_node;
+    l.size_ = l.loose_ = 0;
+    l.blocks_ = nullptr;
+  }
+
+  void repairSentinel() {
+    if (size_ == 0) {
+      not_a_node.next = not_a_node.prev = &not_a_node;
+    } else {
+      not_a_node.next->prev = &not_a_node;
+      not_a_node.prev->next = &not_a_node;
+    }
+  }
+
+  // Merges two nullptr-terminated runs linked through next; on ties the node
+  // from left comes first.
+  template <class Compare>
+  static NodeLinks *mergeRuns(NodeLinks *left, NodeLinks *right,
+                              Compare &comp) {
+    NodeLinks *first = nullptr, **link = &first;
+    while (left && right) {
+      NodeLinks *&next =
+          comp(node(right)->value, node(left)->value) ? right : left;
+      *link = next;
+      link = &next->next;
+      next = next->next;
+    }
+    *link = left ? left : right;
+    return first;
+  }
+
+  // Rebuilds the prev links and the ring through not_a_node from a
+  // nullptr-terminated chain of all the nodes.
+  void relink(NodeLinks *first) {
+    NodeLinks *prev = &not_a_node;
+    for (NodeLinks *i = first; i; i = i->next) {
+      i->prev = prev;
+      prev->next = i;
+      prev = i;
+    }
+    prev->next = &not_a_node;
+    not_a_node.prev = prev;
+  }
 
   template <class S>
   void swap(S *a, S *b) {
@@ -384,4 +547,4 @@ class list {
 
 }  // namespace s21
 
-#endif  // _SRC_S21_LIST_H_
\ No newline at end of file
+#endif  // _SRC_S21_LIST_H_
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_intrusive_list.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Least-recently-used cache. Each entry is one allocation holding the key,
+// the value, its link in the recency list and its link in a chained hash
+// index, so get, put and eviction are O(1) on average.
+//
+// Capacity is a total weight: every entry weighs 1 unless a weigher is
+// given. put evicts from the least recently used end until the new entry
+// fits, calling the eviction callback for each entry it drops; erase,
+// clear and replacing a value do not count as evictions.
+template <class Key, class Value, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<std::pair<const Key, Value>>>
+class lru_cache {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+  using weigher = std::function<size_type(const Key &, const Value &)>;
+  using eviction_callback = std::function<void(const Key &, Value &)>;
+
+  explicit lru_cache(size_type capacity, weigher weigh = weigher(),
+                     const Allocator &alloc = Allocator())
+      : capacity_(capacity),
+        weigh_(std::move(weigh)),
+        buckets(minBuckets),
+        allocator_(alloc) {}
+  lru_cache(size_type capacity, const Allocator &alloc)
+      : lru_cache(capacity, weigher(), alloc) {}
+  lru_cache(const lru_cache &) = delete;
+  lru_cache &operator=(const lru_cache &) = delete;
+  ~lru_cache() { clear(); }
+
+  size_type size() const { return recency.size(); }
+  bool empty() const { return recency.empty(); }
+  size_type weight() const { return weight_; }
+  size_type capacity() const { return capacity_; }
+  allocator_type get_allocator() const { return allocator_; }
+
+  void set_eviction_callback(eviction_callback callback) {
+    evicted = std::move(callback);
+  }
+
+  // Shrinking evicts until the cache fits again.
+  void set_capacity(size_type capacity) {
+    capacity_ = capacity;
+    evictUntil(0);
+  }
+
+  // Marks the entry as most recently used. The pointer stays valid until
+  // the entry is erased, replaced or evicted.
+  Value *get(const Key &key) {
+    Entry *entry = find(key, Hash()(key));
+    if (!entry) return nullptr;
+    recency.splice(recency.end(), recency, recency.iterator_to(*entry));
+    return &entry->value;
+  }
+
+  // Looks the key up without touching its recency.
+  bool contains(const Key &key) const {
+    return find(key, Hash()(key)) != nullptr;
+  }
+
+  // Inserts or replaces the value of key as the most recently used entry.
+  // Returns false, leaving key absent, if the entry alone would exceed the
+  // capacity.
+  template <class V>
+  bool put(const Key &key, V &&value) {
+    size_type hash = Hash()(key);
+    size_type cost = weigh_ ? weigh_(key, value) : 1;
+    Entry *old = find(key, hash);
+    if (cost > capacity_) {
+      if (old) remove(old);
+      return false;
+    }
+    if (old) {
+      old->value = std::forward<V>(value);
+      weight_ = weight_ - old->weight + cost;
+      old->weight = cost;
+      recency.splice(recency.end(), recency, recency.iterator_to(*old));
+      evictUntil(0);
+      return true;
+    }
+    evictUntil(cost);
+    entry_allocator alloc(allocator_);
+    Entry *entry = entry_traits::allocate(alloc, 1);
+    try {
+      entry_traits::construct(alloc, entry, key, std::forward<V>(value));
+    } catch (...) {
+      entry_traits::deallocate(alloc, entry, 1);
+      throw;
+    }
+    entry->hash = hash;
+    entry->weight = cost;
+    if (size() >= buckets.size()) rehash(buckets.size() * 2);
+    Entry *&head = buckets[hash & (buckets.size() - 1)];
+    entry->chain = head;
+    head = entry;
+    recency.push_back(*entry);
+    weight_ += cost;
+    return true;
+  }
+
+  bool erase(const Key &key) {
+    Entry *entry = find(key, Hash()(key));
+    if (entry) remove(entry);
+    return entry != nullptr;
+  }
+
+  void clear() {
+    while (!recency.empty()) remove(&recency.front());
+  }
+
+ private:
+  struct Entry {
+    template <class V>
+    Entry(const Key &k, V &&v) : key(k), value(std::forward<V>(v)) {}
+
+    Key key;
+    Value value;
+    size_type hash = 0;
+    size_type weight = 0;
+    Entry *chain = nullptr;
+    intrusive_list_hook recency;
+  };
+
+  using entry_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>;
+  using entry_traits = std::allocator_traits<entry_allocator>;
+
+  static constexpr size_type minBuckets = 16;
+
+  Entry *find(const Key &key, size_type hash) const {
+    Entry *entry = buckets[hash & (buckets.size() - 1)];
+    while (entry && !(entry->hash == hash && KeyEqual()(entry->key, key))) {
+      entry = entry->chain;
+    }
+    return entry;
+  }
+
+  void evictUntil(size_type room) {
+    while (!recency.empty() && weight_ + room > capacity_) {
+      Entry *victim = &recency.front();
+      if (evicted) evicted(victim->key, victim->value);
+      remove(victim);
+    }
+  }
+
+  void remove(Entry *entry) {
+    Entry **link = &buckets[entry->hash & (buckets.size() - 1)];
+    while (*link != entry) link = &(*link)->chain;
+    *link = entry->chain;
+    recency.erase(*entry);
+    weight_ -= entry->weight;
+    entry_allocator alloc(allocator_);
+    entry_traits::destroy(alloc, entry);
+    entry_traits::deallocate(alloc, entry, 1);
+  }
+
+  void rehash(size_type count) {
+    s21::vector<Entry *> grown(count);
+    for (auto &head : buckets) {
+      while (head) {
+        Entry *entry = head;
+        head = entry->chain;
+        Entry *&target = grown[entry->hash & (count - 1)];
+        entry->chain = target;
+        target = entry;
+      }
+    }
+    buckets.swap(grown);
+  }
+
+  size_type capacity_;
+  size_type weight_ = 0;
+  weigher weigh_;
+  eviction_callback evicted;
+  s21::vector<Entry *> buckets;
+  intrusive_list<Entry, &Entry::recency> recency;
+  Allocator allocator_;
+};
+
+// An lru_cache split into Shards independently locked caches, each with an
+// equal part of the capacity; a key always lands in the same shard. The
+// recency order, and so eviction, is per shard, and so is the limit: put
+// rejects an entry heavier than its shard's part even when the whole cache
+// could hold it, and a capacity below Shards throws std::invalid_argument
+// since some shard would hold nothing. get returns a copy because the entry
+// may be evicted as soon as the shard is unlocked, and the eviction
+// callback runs with the shard locked.
+template <class Key, class Value, size_t Shards = 16,
+          class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<std::pair<const Key, Value>>>
+class sharded_lru_cache {
+  using cache_type = lru_cache<Key, Value, Hash, KeyEqual, Allocator>;
+
+ public:
+  using size_type = size_t;
+  using weigher = typename cache_type::weigher;
+  using eviction_callback = typename cache_type::eviction_callback;
+
+  explicit sharded_lru_cache(size_type capacity, weigher weigh = weigher(),
+                             const Allocator &alloc = Allocator()) {
+    if (capacity < Shards) {
+      throw std::invalid_argument("sharded_lru_cache: capacity below Shards");
+    }
+    shards.reserve(Shards);
+    for (size_type i = 0; i < Shards; i++) {
+      size_type share = capacity / Shards + (i < capacity % Shards ? 1 : 0);
+      shards.push_back(std::make_unique<Shard>(share, weigh, alloc));
+    }
+  }
+  sharded_lru_cache(size_type capacity, const Allocator &alloc)
+      : sharded_lru_cache(capacity, weigher(), alloc) {}
+
+  void set_eviction_callback(const eviction_callback &callback) {
+    for (auto &shard : shards) {
+      std::lock_guard<std::mutex> lock(shard->lock);
+      shard->cache.set_eviction_callback(callback);
+    }
+  }
+
+  std::optional<Value> get(const Key &key) {
+    Shard &shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.lock);
+    Value *value = shard.cache.get(key);
+    if (!value) return std::nullopt;
+    return *value;
+  }
+
+  template <class V>
+  bool put(const Key &key, V &&value) {
+    Shard &shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.lock);
+    return shard.cache.put(key, std::forward<V>(value));
+  }
+
+  bool erase(const Key &key) {
+    Shard &shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.lock);
+    return shard.cache.erase(key);
+  }
+
+  // Sums the shards one at a time, so it is only a snapshot under writes.
+  size_type size() {
+    size_type total = 0;
+    for (auto &shard : shards) {
+      std::lock_guard<std::mutex> lock(shard->lock);
+      total += shard->cache.size();
+    }
+    return total;
+  }
+
+ private:
+  struct alignas(64) Shard {
+    Shard(size_type capacity, const weigher &weigh, const Allocator &alloc)
+        : cache(capacity, weigh, alloc) {}
+
+    std::mutex lock;
+    cache_type cache;
+  };
+
+  // The index takes the high bits of a multiplicative mix so that the low
+  // bits, which pick the bucket inside a shard, stay independent of it.
+  Shard &shardOf(const Key &key) {
+    uint64_t mixed = uint64_t(Hash()(key)) * 0x9E3779B97F4A7C15ull;
+    return *shards[(mixed >> 32) % Shards];
+  }
+
+  s21::vector<std::unique_ptr<Shard>> shards;
+};
+
+}  // namespace s21
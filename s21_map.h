@@ -11,6 +11,8 @@ namespace s21 {
 template <class value_type, class Compare>
 class value_compare {
  public:
+  using key_compare = Compare;
+
   value_compare() : comp(Compare()) {}
 
   bool operator()(const value_type &lhs, const value_type &rhs) {
@@ -22,19 +24,21 @@ class value_compare {
 };
 
 template <class Key, class T, class Compare = std::less<Key>,
-          class Allocator = std::allocator<std::pair<const Key, T>>>
+          class Allocator = std::allocator<std::pair<const Key, T>>,
+          size_t InlineCapacity = 0>
 class map {
   using key_type = Key;
   using mapped_type = T;
   using value_type = std::pair<key_type, mapped_type>;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using NodeT = Node<value_type>;
+  using NodeT = ::Node<value_type, value_compare<value_type, Compare>>;
   using iterator =
-      CTree_iterator<value_type, value_compare<value_type, Compare>, Allocator>;
+      CTree_iterator<value_type, value_compare<value_type, Compare>, Allocator,
+                     tree_null_update, InlineCapacity>;
   using const_iterator =
       const CTree_iterator<value_type, value_compare<value_type, Compare>,
-                           Allocator>;
+                           Allocator, tree_null_update, InlineCapacity>;
   using size_type = size_t;
 
  public:
@@ -95,6 +99,14 @@ class map {
 
   void clear() { tree.removeAllNodes(); }
 
+  void set_finger_search(bool enabled) { tree.setFingerSearch(enabled); }
+
+  void set_lazy_erase(double max_tombstone_fraction) {
+    tree.setTombstoneFraction(max_tombstone_fraction);
+  }
+
+  void compact() { tree.relayout(); }
+
   std::pair<iterator, bool> insert(const value_type &value) {
     auto node = tree.findNode(value);
     if (!tree.isNil(node)) {
@@ -123,6 +135,14 @@ class map {
 
   void erase(iterator pos) { tree.removeNode(*pos); }
   void swap(map &other) { std::swap(*this, other); }
+  void join(map &other) { tree.joinTree(other.tree); }
+
+  map split(const Key &key) {
+    map rest;
+    tree.splitTree(value_type{key, T()}, rest.tree);
+    return rest;
+  }
+
   void merge(map &other) {
     auto it = other.begin();
     while (it != other.end()) {
@@ -149,6 +169,30 @@ class map {
     return tree.isNil(node) ? false : true;
   }
 
+  template <class InputIt, class OutputIt>
+  OutputIt find_batch(InputIt keys_begin, InputIt keys_end, OutputIt out) {
+    tree.findNodes(
+        keys_begin, keys_end,
+        [](const Key &key) { return value_type{key, T()}; },
+        [&](auto node) { *out++ = iterator(tree, node); });
+    return out;
+  }
+
+  template <class Function>
+  void parallel_for_each(Function fn) {
+    tree.parallelForEach(fn);
+  }
+
+  template <class R, class Op, class Combine>
+  R parallel_reduce(R init, Op op, Combine combine) {
+    return tree.parallelReduce(std::move(init), op, combine);
+  }
+
+  template <class R, class Op>
+  R parallel_reduce(R init, Op op) {
+    return tree.parallelReduce(std::move(init), op, op);
+  }
+
   template <class... Args>
   s21::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
     s21::vector<std::pair<iterator, bool>> out;
@@ -157,7 +201,14 @@ class map {
   }
 
  private:
-  CTree<value_type, value_compare<value_type, Compare>, Allocator> tree;
+  CTree<value_type, value_compare<value_type, Compare>, Allocator,
+        tree_null_update, InlineCapacity>
+      tree;
 };
 
+// The map counterpart of small_set.
+template <class Key, class T, size_t InlineCapacity = 8>
+using small_map = map<Key, T, std::less<Key>,
+                      std::allocator<std::pair<const Key, T>>, InlineCapacity>;
+
 };  // namespace s21
\ No newline at end of file
@@ -0,0 +1,496 @@
+#pragma once
+
+#include <stdexcept>
+
+#include "s21_map.h"
+#include "s21_tree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+template <class T, size_t Capacity>
+struct multimap_chunk {
+  alignas(T) unsigned char storage[Capacity * sizeof(T)];
+  size_t used = 0;
+  multimap_chunk *prev = nullptr;
+  multimap_chunk *next = nullptr;
+
+  T *data() { return reinterpret_cast<T *>(storage); }
+};
+
+// All values of one key. The first chunk is stored inside the tree node, so a
+// small group costs a single allocation; overflow chunks are linked after it
+// and never point back at it, which keeps the group movable.
+template <class Key, class T, size_t Capacity, class Allocator>
+struct multimap_group {
+  using chunk = multimap_chunk<T, Capacity>;
+  using chunk_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<chunk>;
+  using chunk_traits = std::allocator_traits<chunk_allocator>;
+
+  Key first;
+  size_t count = 0;
+  chunk values;
+  chunk *overflow = nullptr;
+  chunk *tail = nullptr;
+  chunk_allocator allocator;
+
+  multimap_group() : first() {}
+  explicit multimap_group(const Key &key) : first(key) {}
+  multimap_group(const multimap_group &other)
+      : first(other.first),
+        allocator(chunk_traits::select_on_container_copy_construction(
+            other.allocator)) {
+    append(other);
+  }
+  multimap_group(multimap_group &&other)
+      : first(std::move(other.first)), allocator(other.allocator) {
+    steal(other);
+  }
+  ~multimap_group() { clear(); }
+
+  multimap_group &operator=(const multimap_group &other) {
+    if (this != &other) {
+      clear();
+      first = other.first;
+      append(other);
+    }
+    return *this;
+  }
+
+  multimap_group &operator=(multimap_group &&other) {
+    if (this != &other) {
+      clear();
+      first = std::move(other.first);
+      steal(other);
+    }
+    return *this;
+  }
+
+  chunk *next(chunk *c) { return c == &values ? overflow : c->next; }
+
+  chunk *prev(chunk *c) {
+    return c == &values ? nullptr : c->prev ? c->prev : &values;
+  }
+
+  chunk *last() { return tail ? tail : &values; }
+
+  chunk *append(const T &obj) {
+    auto c = last();
+    if (c->used == Capacity) {
+      c = chunk_traits::allocate(allocator, 1);
+      chunk_traits::construct(allocator, c);
+      c->prev = tail;
+      if (tail) {
+        tail->next = c;
+      } else {
+        overflow = c;
+      }
+      tail = c;
+    }
+    new (c->data() + c->used) T(obj);
+    c->used++;
+    count++;
+    return c;
+  }
+
+  void erase(chunk *c, size_t index) {
+    auto data = c->data();
+    data[index].~T();
+    for (; index + 1 < c->used; index++) {
+      new (data + index) T(std::move(data[index + 1]));
+      data[index + 1].~T();
+    }
+    c->used--;
+    count--;
+    if (c->used == 0 && c != &values) {
+      (c->prev ? c->prev->next : overflow) = c->next;
+      (c->next ? c->next->prev : tail) = c->prev;
+      chunk_traits::destroy(allocator, c);
+      chunk_traits::deallocate(allocator, c, 1);
+    }
+  }
+
+  void clear() {
+    for (auto c = &values; c;) {
+      for (size_t i = 0; i < c->used; i++) c->data()[i].~T();
+      auto following = next(c);
+      if (c != &values) {
+        chunk_traits::destroy(allocator, c);
+        chunk_traits::deallocate(allocator, c, 1);
+      }
+      c = following;
+    }
+    values.used = 0;
+    count = 0;
+    overflow = tail = nullptr;
+  }
+
+ private:
+  void append(const multimap_group &other) {
+    auto group = const_cast<multimap_group *>(&other);
+    for (auto c = &group->values; c; c = group->next(c)) {
+      for (size_t i = 0; i < c->used; i++) append(c->data()[i]);
+    }
+  }
+
+  void steal(multimap_group &other) {
+    for (size_t i = 0; i < other.values.used; i++) {
+      new (values.data() + i) T(std::move(other.values.data()[i]));
+      other.values.data()[i].~T();
+    }
+    values.used = other.values.used;
+    // The overflow chunks change owner, so the allocator that frees them
+    // must come along.
+    allocator = other.allocator;
+    count = other.count;
+    overflow = other.overflow;
+    tail = other.tail;
+    other.values.used = 0;
+    other.count = 0;
+    other.overflow = other.tail = nullptr;
+  }
+};
+
+// GroupChunk == 0 keeps one tree node per element; a positive value stores
+// each key once with its values in chunks of GroupChunk elements.
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>,
+          size_t GroupChunk = 0>
+class multimap {
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using group_type = multimap_group<Key, T, GroupChunk, Allocator>;
+  using chunk = typename group_type::chunk;
+  using group_compare = value_compare<group_type, Compare>;
+  using Tree = CTree<group_type, group_compare, Allocator>;
+  using NodeT = ::Node<group_type, group_compare>;
+  using size_type = size_t;
+
+ public:
+  class MultimapIterator {
+    friend multimap;
+
+   public:
+    MultimapIterator(const Tree &t, NodeT *in, chunk *c = nullptr,
+                     size_type i = 0)
+        : tree(std::addressof(t)), node(in), block(c), index(i) {
+      if (!tree->isNil(node) && !block) {
+        block = &node->item.values;
+        skipEmpty();
+      }
+    }
+
+    std::pair<const Key &, T &> operator*() {
+      return {node->item.first, block->data()[index]};
+    }
+
+    MultimapIterator &operator++() {
+      index++;
+      skipEmpty();
+      return *this;
+    }
+
+    MultimapIterator operator++(int) {
+      auto iter = *this;
+      ++(*this);
+      return iter;
+    }
+
+    MultimapIterator &operator--() {
+      while (!tree->isNil(node) && index == 0) {
+        block = node->item.prev(block);
+        if (!block) {
+          node = tree->prevNode(node);
+          block = tree->isNil(node) ? nullptr : node->item.last();
+        }
+        index = block ? block->used : 0;
+      }
+      if (index) index--;
+      return *this;
+    }
+
+    MultimapIterator operator--(int) {
+      auto iter = *this;
+      --(*this);
+      return iter;
+    }
+
+    bool operator!=(const MultimapIterator &it) const noexcept {
+      return !(*this == it);
+    }
+
+    bool operator==(const MultimapIterator &it) const noexcept {
+      return tree == it.tree && node == it.node && block == it.block &&
+             index == it.index;
+    }
+
+   private:
+    void skipEmpty() {
+      while (!tree->isNil(node) && index == block->used) {
+        block = node->item.next(block);
+        index = 0;
+        if (!block) {
+          node = tree->nextNode(node);
+          block = tree->isNil(node) ? nullptr : &node->item.values;
+        }
+      }
+    }
+
+    const Tree *tree;
+    NodeT *node;
+    chunk *block;
+    size_type index;
+  };
+
+  using iterator = MultimapIterator;
+  using const_iterator = const MultimapIterator;
+
+  multimap() {}
+  multimap(std::initializer_list<value_type> const &items) {
+    for (auto item : items) {
+      insert(item);
+    }
+  }
+  multimap(const multimap &m) {
+    for (auto it = m.cbegin(); it != m.cend(); it++) {
+      insert((*it).first, (*it).second);
+    }
+  }
+  multimap(multimap &&m) noexcept {
+    if (this != &m) {
+      std::swap(tree, m.tree);
+      std::swap(numberOfValues, m.numberOfValues);
+    }
+  }
+  ~multimap() {}
+  multimap &operator=(multimap &&m) {
+    if (this == &m) return *this;
+    std::swap(tree, m.tree);
+    std::swap(numberOfValues, m.numberOfValues);
+    return *this;
+  }
+
+  iterator begin() { return iterator(tree, tree.getFirstNode()); }
+  iterator end() { return iterator(tree, tree.getSentinelNode()); }
+
+  const_iterator cbegin() const {
+    return const_iterator(tree, tree.getFirstNode());
+  }
+  const_iterator cend() const {
+    return const_iterator(tree, tree.getSentinelNode());
+  }
+
+  bool empty() { return numberOfValues == 0; }
+  size_type size() { return numberOfValues; }
+  size_type max_size() { return std::numeric_limits<size_type>::max(); }
+
+  void clear() {
+    tree.removeAllNodes();
+    numberOfValues = 0;
+  }
+
+  void compact() { tree.relayout(); }
+
+  iterator insert(const value_type &value) {
+    return insert(value.first, value.second);
+  }
+
+  iterator insert(const Key &key, const T &obj) {
+    auto node = tree.findNode(group_type(key));
+    if (tree.isNil(node)) {
+      node = tree.insertNode(group_type(key));
+    }
+    auto block = node->item.append(obj);
+    numberOfValues++;
+    return iterator(tree, node, block, block->used - 1);
+  }
+
+  void erase(iterator pos) {
+    auto node = pos.node;
+    node->item.erase(pos.block, pos.index);
+    numberOfValues--;
+    if (node->item.count == 0) {
+      tree.removeNode(node);
+    }
+  }
+
+  void swap(multimap &other) { std::swap(*this, other); }
+
+  void merge(multimap &other) {
+    for (auto it = other.begin(); it != other.end(); it++) {
+      insert((*it).first, (*it).second);
+    }
+    other.clear();
+  }
+
+  iterator find(const Key &key) {
+    return iterator(tree, tree.findNode(group_type(key)));
+  }
+
+  bool contains(const Key &key) {
+    return !tree.isNil(tree.findNode(group_type(key)));
+  }
+
+  size_type count(const Key &key) {
+    auto node = tree.findNode(group_type(key));
+    return tree.isNil(node) ? 0 : node->item.count;
+  }
+
+  iterator lower_bound(const Key &key) {
+    return iterator(tree, tree.lowerBoundNode(group_type(key)));
+  }
+
+  iterator upper_bound(const Key &key) {
+    return iterator(tree, tree.upperBoundNode(group_type(key)));
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  template <class... Args>
+  s21::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
+    s21::vector<std::pair<iterator, bool>> out;
+    out.push_back({insert(value_type(std::forward<Args>(args)...)), true});
+    return out;
+  }
+
+ private:
+  Tree tree;
+  size_type numberOfValues = 0;
+};
+
+template <class Key, class T, class Compare, class Allocator>
+class multimap<Key, T, Compare, Allocator, 0> {
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using entry_compare = value_compare<value_type, Compare>;
+  using NodeT = ::Node<value_type, entry_compare>;
+  using iterator = CTree_iterator<value_type, entry_compare, Allocator>;
+  using const_iterator =
+      const CTree_iterator<value_type, entry_compare, Allocator>;
+  using size_type = size_t;
+
+ public:
+  multimap() {}
+  multimap(std::initializer_list<value_type> const &items) {
+    for (auto item : items) {
+      insert(item);
+    }
+  }
+  multimap(const multimap &m) {
+    for (auto it = m.cbegin(); it != m.cend(); it++) {
+      insert(*it);
+    }
+  }
+  multimap(multimap &&m) noexcept {
+    if (this != &m) {
+      std::swap(tree, m.tree);
+    }
+  }
+  ~multimap() {}
+  multimap &operator=(multimap &&m) {
+    if (this == &m) return *this;
+    std::swap(tree, m.tree);
+    return *this;
+  }
+
+  iterator begin() { return iterator(tree, tree.getFirstNode()); }
+  iterator end() { return iterator(tree, tree.getSentinelNode()); }
+
+  const_iterator cbegin() const {
+    return const_iterator(tree, tree.getFirstNode());
+  }
+  const_iterator cend() const {
+    return const_iterator(tree, tree.getSentinelNode());
+  }
+
+  bool empty() { return tree.getNumberOfNodes() == 0; }
+  size_type size() { return tree.getNumberOfNodes(); }
+  size_type max_size() { return std::numeric_limits<size_type>::max(); }
+
+  void clear() { tree.removeAllNodes(); }
+
+  void compact() { tree.relayout(); }
+
+  iterator insert(const value_type &value) {
+    return iterator(tree, tree.insertNode(value));
+  }
+
+  iterator insert(const Key &key, const T &obj) {
+    return insert(value_type{key, obj});
+  }
+
+  void erase(iterator pos) { tree.removeNode(pos.getNode()); }
+  void swap(multimap &other) { std::swap(*this, other); }
+
+  void merge(multimap &other) {
+    for (auto it = other.begin(); it != other.end(); it++) {
+      insert(*it);
+    }
+    other.clear();
+  }
+
+  iterator find(const Key &key) {
+    auto node = tree.lowerBoundNode(value_type{key, T()});
+    if (!tree.isNil(node) && comp(key, node->item.first)) {
+      node = tree.getSentinelNode();
+    }
+    return iterator(tree, node);
+  }
+
+  bool contains(const Key &key) { return find(key) != end(); }
+
+  size_type count(const Key &key) {
+    value_type probe{key, T()};
+    return rank(tree.upperBoundNode(probe)) - rank(tree.lowerBoundNode(probe));
+  }
+
+  iterator lower_bound(const Key &key) {
+    return iterator(tree, tree.lowerBoundNode(value_type{key, T()}));
+  }
+
+  iterator upper_bound(const Key &key) {
+    return iterator(tree, tree.upperBoundNode(value_type{key, T()}));
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  template <class... Args>
+  s21::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
+    s21::vector<std::pair<iterator, bool>> out;
+    out.push_back({insert(value_type(std::forward<Args>(args)...)), true});
+    return out;
+  }
+
+ private:
+  // Number of elements ordered before node, or size() for the sentinel. The
+  // tree keeps subtree sizes in Node::count, and the sentinel's is 0.
+  size_type rank(NodeT *node) {
+    if (tree.isNil(node)) {
+      return tree.getNumberOfNodes();
+    }
+    size_type result = node->left->count;
+    for (; node->parent; node = node->parent) {
+      if (node->on_right()) {
+        result += node->parent->left->count + 1;
+      }
+    }
+    return result;
+  }
+
+  Compare comp;
+  CTree<value_type, entry_compare, Allocator> tree;
+};
+
+template <class Key, class T, size_t GroupChunk = 16>
+using grouped_multimap =
+    multimap<Key, T, std::less<Key>, std::allocator<std::pair<const Key, T>>,
+             GroupChunk>;
+
+};  // namespace s21
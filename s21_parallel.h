@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "s21_vector.h"
+
+namespace s21 {
+
+inline size_t parallel_threads() {
+  auto threads = std::thread::hardware_concurrency();
+  return threads ? threads : 1;
+}
+
+// Worker threads shared by every parallel_run. The pool starts on first use
+// with one thread fewer than the hardware runs, since the calling thread
+// always works too, and stops at exit.
+class parallel_pool {
+ public:
+  static parallel_pool &shared() {
+    static parallel_pool pool(parallel_threads() - 1);
+    return pool;
+  }
+
+  parallel_pool(const parallel_pool &) = delete;
+  parallel_pool &operator=(const parallel_pool &) = delete;
+
+  ~parallel_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (auto &thread : threads) thread.join();
+  }
+
+  // Runs work() on the calling thread and on up to `helpers` pool threads,
+  // returning once every copy has finished. Copies still queued when the
+  // caller's own finishes are withdrawn rather than waited for, so a
+  // parallel_run nested in a task cannot wait on threads that are busy
+  // waiting themselves.
+  template <class Work>
+  void run(size_t helpers, Work &work) {
+    Batch batch([](void *context) { (*static_cast<Work *>(context))(); },
+                &work);
+    if (helpers > threads.size()) helpers = threads.size();
+    if (helpers) {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (size_t i = 0; i < helpers; i++) queue.push_back(&batch);
+      batch.queued = helpers;
+    }
+    if (helpers) wake.notify_all();
+    work();
+    if (!helpers) return;
+    std::unique_lock<std::mutex> lock(mutex);
+    if (batch.queued) {
+      size_t kept = 0;
+      for (auto queued : queue) {
+        if (queued != &batch) queue[kept++] = queued;
+      }
+      while (queue.size() > kept) queue.pop_back();
+      batch.queued = 0;
+    }
+    batch.done.wait(lock, [&] { return batch.running == 0; });
+  }
+
+ private:
+  struct Batch {
+    Batch(void (*c)(void *), void *w) : call(c), work(w) {}
+
+    void (*call)(void *);
+    void *work;
+    size_t queued = 0;
+    size_t running = 0;
+    std::condition_variable done;
+  };
+
+  explicit parallel_pool(size_t count) {
+    threads.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+      threads.emplace_back([this] { serve(); });
+    }
+  }
+
+  void serve() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+      wake.wait(lock, [&] { return stopping || !queue.empty(); });
+      if (queue.empty()) return;
+      Batch *batch = queue.back();
+      queue.pop_back();
+      batch->queued--;
+      batch->running++;
+      lock.unlock();
+      batch->call(batch->work);
+      lock.lock();
+      if (--batch->running == 0 && batch->queued == 0) {
+        batch->done.notify_all();
+      }
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable wake;
+  s21::vector<Batch *> queue;
+  s21::vector<std::thread> threads;
+  bool stopping = false;
+};
+
+// Runs task(0) .. task(count - 1) on up to `threads` threads, the calling one
+// included, taking the helpers from parallel_pool::shared(). Workers pull
+// indices from a shared counter, so uneven tasks balance out; the first
+// exception thrown by a task is rethrown here.
+template <class Task>
+void parallel_run(size_t count, size_t threads, Task task) {
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&] {
+    for (size_t i; (i = next.fetch_add(1)) < count;) {
+      try {
+        task(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) error = std::current_exception();
+      }
+    }
+  };
+
+  if (threads > count) threads = count;
+  parallel_pool::shared().run(threads > 1 ? threads - 1 : 0, worker);
+  if (error) std::rethrow_exception(error);
+}
+
+}  // namespace s21
@@ -1,36 +1,70 @@
 #ifndef _SRC_S21_QUEUE_H_
 #define _SRC_S21_QUEUE_H_
 
-#include "s21_list.h"
+#include <memory>
+#include <type_traits>
+
+#include "s21_ring_buffer.h"
 
 namespace s21 {
 
-template <class T>
-class queue : public list<T> {
+// FIFO adapter over any Container with front, back, emplace_back,
+// pop_front, size and swap; s21::list<T> still works as one.
+template <class T, class Container = ring_buffer<T>>
+class queue {
  public:
+  using container_type = Container;
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
   using size_type = std::size_t;
 
-  queue() : list<T>() {}
-  queue(std::size_t n) : list<T>(n) {}
-  queue(std::initializer_list<value_type> const &items) : list<T>(items) {}
-  queue(const queue &q) : list<T>(q) {}
-  queue(queue &&q) : list<T>(q) { q.list<T>::clear(); }
-  queue &operator=(queue &&q) {
-    list<T>::operator=(q);
-    q.list<T>::clear();
+  queue() : c() {}
+  explicit queue(const Container &cont) : c(cont) {}
+  explicit queue(Container &&cont) : c(std::move(cont)) {}
+  template <class Alloc, std::enable_if_t<
+                             std::uses_allocator<Container, Alloc>::value,
+                             bool> = true>
+  explicit queue(const Alloc &alloc) : c(alloc) {}
+  queue(std::size_t n) : c(n) {}
+  queue(std::initializer_list<value_type> const &items) : c(items) {}
+  queue(const queue &q) : c(q.c) {}
+  queue(queue &&q) noexcept(
+      std::is_nothrow_move_constructible<Container>::value)
+      : c(std::move(q.c)) {}
+  queue &operator=(queue &&q) noexcept(
+      std::is_nothrow_move_assignable<Container>::value) {
+    c = std::move(q.c);
     return *this;
   }
-  bool operator==(queue other) const { return list<T>::operator==(other); }
   queue &operator=(const queue &q) {
-    list<T>::operator=(q);
+    c = q.c;
     return *this;
   }
+  bool operator==(const queue &other) const { return c == other.c; }
+
+  reference front() { return c.front(); }
+  const_reference front() const { return c.front(); }
+  reference back() { return c.back(); }
+  const_reference back() const { return c.back(); }
+  bool empty() const { return c.empty(); }
+  size_type size() const { return c.size(); }
+
+  void push(const_reference value) { c.push_back(value); }
+  void push(value_type &&value) { c.push_back(std::move(value)); }
+  void pop() {
+    if (!c.empty()) c.pop_front();
+  }
+  void swap(queue &other) { c.swap(other.c); }
+
+  // Appends one element per argument, each constructed from it.
+  template <class... Args>
+  void emplace_back(Args &&...args) {
+    (c.emplace_back(std::forward<Args>(args)), ...);
+  }
 
-  void push(const_reference value) { list<T>::push_back(value); }
-  void pop() { list<T>::pop_front(); }
+ protected:
+  Container c;
 };
 }  // namespace s21
 
@@ -0,0 +1,271 @@
+#ifndef _SRC_S21_RING_BUFFER_H_
+#define _SRC_S21_RING_BUFFER_H_
+
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+namespace s21 {
+
+// A growable circular array: both ends take pushes and pops in O(1), and a
+// full buffer doubles into fresh storage, so the elements stay contiguous
+// modulo one wrap. The capacity is a power of two so that the wrap is a
+// mask.
+template <class T, class Allocator = std::allocator<T>>
+class ring_buffer {
+  using allocator_traits = std::allocator_traits<Allocator>;
+
+ public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = size_t;
+  using reference = T &;
+  using const_reference = const T &;
+
+  ring_buffer() noexcept(noexcept(Allocator())) : ring_buffer(Allocator()) {}
+
+  explicit ring_buffer(const Allocator &alloc) noexcept : allocator_(alloc) {}
+
+  explicit ring_buffer(size_type n, const Allocator &alloc = Allocator())
+      : allocator_(alloc) {
+    reserve(n);
+    while (size_ != n) emplace_back();
+  }
+
+  ring_buffer(std::initializer_list<T> items,
+              const Allocator &alloc = Allocator())
+      : allocator_(alloc) {
+    reserve(items.size());
+    for (const auto &item : items) push_back(item);
+  }
+
+  ring_buffer(const ring_buffer &other)
+      : ring_buffer(other,
+                    allocator_traits::select_on_container_copy_construction(
+                        other.allocator_)) {}
+
+  ring_buffer(const ring_buffer &other, const Allocator &alloc)
+      : allocator_(alloc) {
+    reserve(other.size_);
+    for (size_type i = 0; i < other.size_; i++) push_back(other[i]);
+  }
+
+  ring_buffer(ring_buffer &&other) noexcept
+      : data_(other.data_),
+        capacity_(other.capacity_),
+        head_(other.head_),
+        size_(other.size_),
+        allocator_(std::move(other.allocator_)) {
+    other.data_ = nullptr;
+    other.capacity_ = other.head_ = other.size_ = 0;
+  }
+
+  ring_buffer &operator=(const ring_buffer &other) {
+    if (this != &other) {
+      if (allocator_traits::propagate_on_container_copy_assignment::value) {
+        clear();
+        release();
+        allocator_ = other.allocator_;
+      }
+      ring_buffer copy(other, allocator_);
+      swapStorage(copy);
+    }
+    return *this;
+  }
+
+  ring_buffer &operator=(ring_buffer &&other) noexcept(
+      allocator_traits::propagate_on_container_move_assignment::value ||
+      allocator_traits::is_always_equal::value) {
+    if (this == &other) return *this;
+    clear();
+    if (allocator_traits::propagate_on_container_move_assignment::value ||
+        allocator_ == other.allocator_) {
+      release();
+      if (allocator_traits::propagate_on_container_move_assignment::value) {
+        allocator_ = other.allocator_;
+      }
+      swapStorage(other);
+    } else {
+      reserve(other.size_);
+      for (size_type i = 0; i < other.size_; i++) {
+        push_back(std::move(other[i]));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+
+  ~ring_buffer() {
+    clear();
+    release();
+  }
+
+  allocator_type get_allocator() const { return allocator_; }
+
+  reference operator[](size_type pos) { return data_[slot(pos)]; }
+  const_reference operator[](size_type pos) const { return data_[slot(pos)]; }
+
+  reference front() { return data_[head_]; }
+  const_reference front() const { return data_[head_]; }
+  reference back() { return data_[slot(size_ - 1)]; }
+  const_reference back() const { return data_[slot(size_ - 1)]; }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type capacity() const { return capacity_; }
+  size_type max_size() const { return allocator_traits::max_size(allocator_); }
+
+  void reserve(size_type n) {
+    if (n <= capacity_) return;
+    size_type grown = minCapacity;
+    while (grown < n) grown *= 2;
+    T *fresh = allocator_traits::allocate(allocator_, grown);
+    try {
+      relocate(fresh, grown, 0);
+    } catch (...) {
+      allocator_traits::deallocate(allocator_, fresh, grown);
+      throw;
+    }
+  }
+
+  void clear() noexcept {
+    for (size_type i = 0; i < size_; i++) {
+      allocator_traits::destroy(allocator_, data_ + slot(i));
+    }
+    head_ = size_ = 0;
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+  void push_front(const T &value) { emplace_front(value); }
+  void push_front(T &&value) { emplace_front(std::move(value)); }
+
+  template <class... Args>
+  reference emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      growWith(size_, std::forward<Args>(args)...);
+    } else {
+      allocator_traits::construct(allocator_, data_ + slot(size_),
+                                  std::forward<Args>(args)...);
+    }
+    size_++;
+    return back();
+  }
+
+  template <class... Args>
+  reference emplace_front(Args &&...args) {
+    if (size_ == capacity_) {
+      growWith(0, std::forward<Args>(args)...);
+    } else {
+      size_type first = (head_ + capacity_ - 1) & (capacity_ - 1);
+      allocator_traits::construct(allocator_, data_ + first,
+                                  std::forward<Args>(args)...);
+      head_ = first;
+    }
+    size_++;
+    return front();
+  }
+
+  void pop_front() {
+    allocator_traits::destroy(allocator_, data_ + head_);
+    head_ = (head_ + 1) & (capacity_ - 1);
+    size_--;
+  }
+
+  void pop_back() {
+    allocator_traits::destroy(allocator_, data_ + slot(size_ - 1));
+    size_--;
+  }
+
+  void swap(ring_buffer &other) noexcept {
+    if (allocator_traits::propagate_on_container_swap::value) {
+      std::swap(allocator_, other.allocator_);
+    }
+    swapStorage(other);
+  }
+
+  bool operator==(const ring_buffer &other) const {
+    if (size_ != other.size_) return false;
+    for (size_type i = 0; i < size_; i++) {
+      if (!((*this)[i] == other[i])) return false;
+    }
+    return true;
+  }
+
+ private:
+  static constexpr size_type minCapacity = 8;
+
+  size_type slot(size_type pos) const {
+    return (head_ + pos) & (capacity_ - 1);
+  }
+
+  // Builds the new element in doubled storage before moving the old ones,
+  // so args may refer to an element of this buffer. pos is 0 for a push at
+  // the front and size_ for one at the back.
+  template <class... Args>
+  void growWith(size_type pos, Args &&...args) {
+    size_type grown = capacity_ ? capacity_ * 2 : minCapacity;
+    T *fresh = allocator_traits::allocate(allocator_, grown);
+    try {
+      allocator_traits::construct(allocator_, fresh + pos,
+                                  std::forward<Args>(args)...);
+    } catch (...) {
+      allocator_traits::deallocate(allocator_, fresh, grown);
+      throw;
+    }
+    try {
+      relocate(fresh, grown, pos == 0 ? 1 : 0);
+    } catch (...) {
+      allocator_traits::destroy(allocator_, fresh + pos);
+      allocator_traits::deallocate(allocator_, fresh, grown);
+      throw;
+    }
+  }
+
+  // Moves the elements to fresh[first, first + size_) and adopts fresh,
+  // which must hold grown elements. On failure the buffer is left as it
+  // was and fresh is left to the caller.
+  void relocate(T *fresh, size_type grown, size_type first) {
+    size_type built = 0;
+    try {
+      for (; built < size_; built++) {
+        allocator_traits::construct(allocator_, fresh + first + built,
+                                    std::move_if_noexcept((*this)[built]));
+      }
+    } catch (...) {
+      while (built) {
+        allocator_traits::destroy(allocator_, fresh + first + --built);
+      }
+      throw;
+    }
+    size_type count = size_;
+    clear();
+    release();
+    data_ = fresh;
+    capacity_ = grown;
+    size_ = count;
+  }
+
+  void release() noexcept {
+    if (data_) allocator_traits::deallocate(allocator_, data_, capacity_);
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+
+  void swapStorage(ring_buffer &other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+  T *data_ = nullptr;
+  size_type capacity_ = 0;
+  size_type head_ = 0;
+  size_type size_ = 0;
+  Allocator allocator_;
+};
+
+}  // namespace s21
+
+#endif  // _SRC_S21_RING_BUFFER_H_
@@ -9,16 +9,18 @@
 namespace s21 {
 
 template <bool unique, class Key, class Compare = std::less<Key>,
-          class Allocator = std::allocator<Key>>
+          class Allocator = std::allocator<Key>, size_t InlineCapacity = 0>
 class set_base {
  public:
   using key_type = Key;
   using value_type = Key;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using NodeT = Node<value_type>;
-  using iterator = CTree_iterator<value_type, Compare, Allocator>;
-  using const_iterator = const CTree_iterator<value_type, Compare, Allocator>;
+  using NodeT = ::Node<value_type, Compare>;
+  using iterator = CTree_iterator<value_type, Compare, Allocator,
+                                  tree_null_update, InlineCapacity>;
+  using const_iterator = const CTree_iterator<value_type, Compare, Allocator,
+                                              tree_null_update, InlineCapacity>;
   using size_type = size_t;
 
   set_base() {}
@@ -61,6 +63,14 @@ class set_base {
 
   void clear() { tree.removeAllNodes(); }
 
+  void set_finger_search(bool enabled) { tree.setFingerSearch(enabled); }
+
+  void set_lazy_erase(double max_tombstone_fraction) {
+    tree.setTombstoneFraction(max_tombstone_fraction);
+  }
+
+  void compact() { tree.relayout(); }
+
   std::pair<iterator, bool> insert(const value_type &value) {
     if (unique) {
       auto node = tree.findNode(value);
@@ -78,6 +88,7 @@ class set_base {
 
   void erase(iterator pos) { tree.removeNode(*pos); }
   void swap(set_base &other) { std::swap(*this, other); }
+  void join(set_base &other) { tree.joinTree(other.tree); }
 
   void merge(set_base &other) {
     auto it = other.begin();
@@ -130,6 +141,29 @@ class set_base {
     return tree.isNil(node) ? false : true;
   }
 
+  template <class InputIt, class OutputIt>
+  OutputIt contains_batch(InputIt keys_begin, InputIt keys_end, OutputIt out) {
+    tree.findNodes(
+        keys_begin, keys_end, [](const Key &key) { return value_type{key}; },
+        [&](auto node) { *out++ = !tree.isNil(node); });
+    return out;
+  }
+
+  template <class Function>
+  void parallel_for_each(Function fn) {
+    tree.parallelForEach(fn);
+  }
+
+  template <class R, class Op, class Combine>
+  R parallel_reduce(R init, Op op, Combine combine) {
+    return tree.parallelReduce(std::move(init), op, combine);
+  }
+
+  template <class R, class Op>
+  R parallel_reduce(R init, Op op) {
+    return tree.parallelReduce(std::move(init), op, op);
+  }
+
   template <class... Args>
   s21::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
     s21::vector<std::pair<iterator, bool>> out;
@@ -138,18 +172,31 @@ class set_base {
   }
 
  protected:
-  CTree<value_type, Compare, Allocator> tree;
+  CTree<value_type, Compare, Allocator, tree_null_update, InlineCapacity> tree;
 };
 
 template <class Key, class Compare = std::less<Key>,
-          class Allocator = std::allocator<Key>>
-class set : public set_base<true, Key, Compare, Allocator> {
+          class Allocator = std::allocator<Key>, size_t InlineCapacity = 0>
+class set : public set_base<true, Key, Compare, Allocator, InlineCapacity> {
  public:
-  using base_class = set_base<true, Key, Compare, Allocator>;
+  using base_class = set_base<true, Key, Compare, Allocator, InlineCapacity>;
 
   set() : base_class() {}
 
   set(std::initializer_list<Key> const &items) : base_class(items) {}
+
+  set split(const Key &key) {
+    set rest;
+    this->tree.splitTree(key, rest.tree);
+    return rest;
+  }
 };
 
+// Keeps up to InlineCapacity elements inside the object. Inserting and
+// erasing leave the other elements in place; growing past the capacity
+// moves them into tree nodes, and moving the container moves them too, so
+// both invalidate iterators.
+template <class Key, size_t InlineCapacity = 8>
+using small_set = set<Key, std::less<Key>, std::allocator<Key>, InlineCapacity>;
+
 };  // namespace s21
\ No newline at end of file
@@ -1,40 +1,69 @@
 #ifndef _SRC_S21_STACK_H_
 #define _SRC_S21_STACK_H_
 
-#include "s21_list.h"
+#include <memory>
+#include <type_traits>
+
+#include "s21_vector.h"
 
 namespace s21 {
-template <class T>
-class stack : public list<T> {
+// LIFO adapter over any Container with back, emplace_back, pop_back, size
+// and swap; s21::list<T> still works as one.
+template <class T, class Container = vector<T>>
+class stack {
  public:
+  using container_type = Container;
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
   using size_type = size_t;
 
-  stack() : list<T>(){};
-  stack(std::size_t n) : list<T>(n) {}
-  stack(std::initializer_list<T> const &items) : list<T>(items) {}
-  stack(const stack &s) : list<T>(s) {}
-  stack(stack &&s) : list<T>(s) { s.list<T>::clear(); }
-  stack &operator=(stack &&s) {
-    list<T>::operator=(s);
-    s.list<T>::clear();
+  stack() : c(){};
+  explicit stack(const Container &cont) : c(cont) {}
+  explicit stack(Container &&cont) : c(std::move(cont)) {}
+  template <class Alloc, std::enable_if_t<
+                             std::uses_allocator<Container, Alloc>::value,
+                             bool> = true>
+  explicit stack(const Alloc &alloc) : c(alloc) {}
+  stack(std::size_t n) : c(n) {}
+  stack(std::initializer_list<T> const &items) : c(items) {}
+  stack(const stack &s) : c(s.c) {}
+  stack(stack &&s) noexcept(
+      std::is_nothrow_move_constructible<Container>::value)
+      : c(std::move(s.c)) {}
+  stack &operator=(stack &&s) noexcept(
+      std::is_nothrow_move_assignable<Container>::value) {
+    c = std::move(s.c);
+    return *this;
+  }
+  stack &operator=(const stack &s) {
+    c = s.c;
     return *this;
   }
 
-  const_reference top() { return *(--list<T>::end()); }
-  void push(const_reference value) { list<T>::push_back(value); }
+  reference top() { return c.back(); }
+  const_reference top() const { return c.back(); }
+  bool empty() const { return c.empty(); }
+  size_type size() const { return c.size(); }
+
+  void push(const_reference value) { c.push_back(value); }
+  void push(value_type &&value) { c.push_back(std::move(value)); }
   void pop() {
-    if (list<T>::size() != 0) list<T>::pop_back();
+    if (c.size() != 0) c.pop_back();
   }
+  void swap(stack &other) { c.swap(other.c); }
 
+  // Pushes one element per argument, each constructed from it, so the last
+  // argument ends up on top.
   template <typename... Args>
   void emplace_front(Args &&...args) {
-    list<T>::emplace_back(args...);
+    (c.emplace_back(std::forward<Args>(args)), ...);
   }
+
+ protected:
+  Container c;
 };
 
 }  // namespace s21
 
-#endif  // _SRC_S21_STACK_H_
\ No newline at end of file
+#endif  // _SRC_S21_STACK_H_
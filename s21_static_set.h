@@ -0,0 +1,331 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include "s21_map.h"
+#include "s21_set.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Keys are stored once, in Eytzinger (BFS) order in slots 1..n: the children
+// of slot k are 2k and 2k + 1, so a descent reads one predictable address per
+// level and the subtree a few levels down sits in a single cache line.
+template <class Key, class Compare = std::less<Key>>
+class eytzinger_index {
+ public:
+  using size_type = size_t;
+
+  static constexpr size_type prefetchStride =
+      sizeof(Key) < 64 ? 64 / sizeof(Key) : 1;
+
+  // In-order successor of slot k, or 0 past the last one.
+  static size_type next(size_type k, size_type n) {
+    if (2 * k + 1 <= n) {
+      k = 2 * k + 1;
+      while (2 * k <= n) k = 2 * k;
+      return k;
+    }
+    while (k & 1) k >>= 1;
+    return k >> 1;
+  }
+
+  static size_type prev(size_type k, size_type n) {
+    if (2 * k <= n) {
+      k = 2 * k;
+      while (2 * k + 1 <= n) k = 2 * k + 1;
+      return k;
+    }
+    while (k > 1 && !(k & 1)) k >>= 1;
+    return k >> 1;
+  }
+
+  static size_type first(size_type n) {
+    size_type k = n ? 1 : 0;
+    while (2 * k <= n && k) k = 2 * k;
+    return k;
+  }
+
+  // Branchless descent; the final shift drops the trailing right turns plus
+  // the last left turn, which leaves the slot of the first key >= key.
+  static size_type lowerBound(const Key *data, size_type n, const Key &key) {
+    Compare comp;
+    size_type k = 1;
+    auto base = reinterpret_cast<uintptr_t>(data);
+    while (k <= n) {
+      __builtin_prefetch(reinterpret_cast<const void *>(
+          base + k * prefetchStride * sizeof(Key)));
+      k = 2 * k + comp(data[k], key);
+    }
+    return k >> __builtin_ffsll(~static_cast<unsigned long long>(k));
+  }
+
+  template <class Source, class Slots>
+  static void fill(Source &sorted, Slots &slots, size_type &i, size_type k,
+                   size_type n) {
+    if (k <= n) {
+      fill(sorted, slots, i, 2 * k, n);
+      slots[k] = std::move(sorted[i++]);
+      fill(sorted, slots, i, 2 * k + 1, n);
+    }
+  }
+};
+
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>>
+class static_set {
+  using index = eytzinger_index<Key, Compare>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+
+  class StaticSetIterator {
+    friend static_set;
+
+   public:
+    StaticSetIterator(const static_set *s, size_type k) : set(s), slot(k) {}
+
+    const_reference operator*() const { return set->keys[slot]; }
+
+    StaticSetIterator &operator++() {
+      slot = index::next(slot, set->size());
+      return *this;
+    }
+
+    StaticSetIterator operator++(int) {
+      auto iter = *this;
+      ++(*this);
+      return iter;
+    }
+
+    StaticSetIterator &operator--() {
+      slot = index::prev(slot, set->size());
+      return *this;
+    }
+
+    StaticSetIterator operator--(int) {
+      auto iter = *this;
+      --(*this);
+      return iter;
+    }
+
+    bool operator!=(const StaticSetIterator &it) const noexcept {
+      return set != it.set || slot != it.slot;
+    }
+
+    bool operator==(const StaticSetIterator &it) const noexcept {
+      return set == it.set && slot == it.slot;
+    }
+
+   private:
+    const static_set *set;
+    size_type slot;
+  };
+
+  using iterator = StaticSetIterator;
+  using const_iterator = StaticSetIterator;
+
+  static_set() : keys(1) {}
+
+  template <class InputIt,
+            std::enable_if_t<!std::is_integral<InputIt>::value, bool> = true>
+  static_set(InputIt first, InputIt last) {
+    s21::vector<Key, Allocator> sorted;
+    for (; first != last; ++first) sorted.push_back(*first);
+    Compare comp;
+    if (!std::is_sorted(sorted.begin(), sorted.end(), comp)) {
+      std::sort(sorted.begin(), sorted.end(), comp);
+    }
+    auto equal = [&](const Key &lhs, const Key &rhs) {
+      return !comp(lhs, rhs) && !comp(rhs, lhs);
+    };
+    sorted.erase(std::unique(sorted.begin(), sorted.end(), equal),
+                 sorted.end());
+    build(sorted);
+  }
+
+  explicit static_set(const s21::vector<Key, Allocator> &items)
+      : static_set(items.begin(), items.end()) {}
+
+  template <class SetAllocator, size_t InlineCapacity>
+  explicit static_set(const set<Key, Compare, SetAllocator, InlineCapacity> &s)
+      : static_set(s.cbegin(), s.cend()) {}
+
+  static_set(std::initializer_list<value_type> const &items)
+      : static_set(items.begin(), items.end()) {}
+
+  iterator begin() const { return iterator(this, index::first(size())); }
+  iterator end() const { return iterator(this, 0); }
+
+  bool empty() const { return size() == 0; }
+  size_type size() const { return keys.size() - 1; }
+
+  iterator lower_bound(const Key &key) const {
+    return iterator(this, index::lowerBound(keys.data(), size(), key));
+  }
+
+  iterator find(const Key &key) const {
+    auto slot = index::lowerBound(keys.data(), size(), key);
+    return iterator(this, slot && !Compare()(key, keys[slot]) ? slot : 0);
+  }
+
+  bool contains(const Key &key) const { return find(key) != end(); }
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+ private:
+  void build(s21::vector<Key, Allocator> &sorted) {
+    keys.resize(sorted.size() + 1);
+    size_type i = 0;
+    index::fill(sorted, keys, i, 1, sorted.size());
+  }
+
+  s21::vector<Key, Allocator> keys;
+};
+
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class static_map {
+  using index = eytzinger_index<Key, Compare>;
+  using key_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Key>;
+  using mapped_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using size_type = size_t;
+
+  class StaticMapIterator {
+    friend static_map;
+
+   public:
+    StaticMapIterator(static_map *m, size_type k) : map(m), slot(k) {}
+
+    std::pair<const Key &, T &> operator*() const {
+      return {map->keys[slot], map->values[slot]};
+    }
+
+    StaticMapIterator &operator++() {
+      slot = index::next(slot, map->size());
+      return *this;
+    }
+
+    StaticMapIterator operator++(int) {
+      auto iter = *this;
+      ++(*this);
+      return iter;
+    }
+
+    StaticMapIterator &operator--() {
+      slot = index::prev(slot, map->size());
+      return *this;
+    }
+
+    StaticMapIterator operator--(int) {
+      auto iter = *this;
+      --(*this);
+      return iter;
+    }
+
+    bool operator!=(const StaticMapIterator &it) const noexcept {
+      return map != it.map || slot != it.slot;
+    }
+
+    bool operator==(const StaticMapIterator &it) const noexcept {
+      return map == it.map && slot == it.slot;
+    }
+
+   private:
+    static_map *map;
+    size_type slot;
+  };
+
+  using iterator = StaticMapIterator;
+
+  static_map() : keys(1), values(1) {}
+
+  template <class InputIt,
+            std::enable_if_t<!std::is_integral<InputIt>::value, bool> = true>
+  static_map(InputIt first, InputIt last) {
+    s21::vector<value_type> sorted;
+    for (; first != last; ++first) {
+      auto item = *first;
+      sorted.push_back(value_type(item.first, item.second));
+    }
+    Compare comp;
+    auto less = [&](const value_type &lhs, const value_type &rhs) {
+      return comp(lhs.first, rhs.first);
+    };
+    auto equal = [&](const value_type &lhs, const value_type &rhs) {
+      return !less(lhs, rhs) && !less(rhs, lhs);
+    };
+    std::stable_sort(sorted.begin(), sorted.end(), less);
+    sorted.erase(std::unique(sorted.begin(), sorted.end(), equal),
+                 sorted.end());
+
+    s21::vector<Key, key_allocator> sorted_keys;
+    s21::vector<T, mapped_allocator> sorted_values;
+    sorted_keys.reserve(sorted.size());
+    sorted_values.reserve(sorted.size());
+    for (auto &item : sorted) {
+      sorted_keys.push_back(std::move(item.first));
+      sorted_values.push_back(std::move(item.second));
+    }
+    keys.resize(sorted.size() + 1);
+    values.resize(sorted.size() + 1);
+    size_type i = 0;
+    index::fill(sorted_keys, keys, i, 1, sorted.size());
+    i = 0;
+    index::fill(sorted_values, values, i, 1, sorted.size());
+  }
+
+  explicit static_map(const s21::vector<value_type> &items)
+      : static_map(items.begin(), items.end()) {}
+
+  template <class MapAllocator, size_t InlineCapacity>
+  explicit static_map(
+      const map<Key, T, Compare, MapAllocator, InlineCapacity> &m)
+      : static_map(m.cbegin(), m.cend()) {}
+
+  static_map(std::initializer_list<value_type> const &items)
+      : static_map(items.begin(), items.end()) {}
+
+  iterator begin() { return iterator(this, index::first(size())); }
+  iterator end() { return iterator(this, 0); }
+
+  bool empty() const { return size() == 0; }
+  size_type size() const { return keys.size() - 1; }
+
+  T &at(const Key &key) {
+    auto slot = findSlot(key);
+    if (!slot) {
+      throw std::out_of_range("out_of_range");
+    }
+    return values[slot];
+  }
+
+  iterator lower_bound(const Key &key) {
+    return iterator(this, index::lowerBound(keys.data(), size(), key));
+  }
+
+  iterator find(const Key &key) { return iterator(this, findSlot(key)); }
+  bool contains(const Key &key) const { return findSlot(key) != 0; }
+
+ private:
+  size_type findSlot(const Key &key) const {
+    auto slot = index::lowerBound(keys.data(), size(), key);
+    return slot && !Compare()(key, keys[slot]) ? slot : 0;
+  }
+
+  s21::vector<Key, key_allocator> keys;
+  s21::vector<T, mapped_allocator> values;
+};
+
+};  // namespace s21
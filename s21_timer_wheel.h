@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "s21_list.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Hierarchical timing wheel. Level L has slotCount buckets, each covering
+// 2^(SlotBits * L) ticks; a timer sits in the lowest level whose range
+// still reaches its deadline and cascades one level down each time the
+// wheel above it turns to its bucket. Schedule and cancel are O(1); a tick
+// fires its whole level-0 bucket as one batch.
+//
+// Timers are kept in a table and the buckets hold their indices, so a
+// handle survives cascading and a stale handle is recognised by its
+// generation.
+template <class Callback = std::function<void()>, size_t SlotBits = 8,
+          size_t Levels = 4>
+class timer_wheel {
+ public:
+  using tick_type = uint64_t;
+  using size_type = size_t;
+
+  static constexpr size_type slotCount = size_type(1) << SlotBits;
+  static constexpr tick_type maxDelay =
+      SlotBits * Levels >= 64 ? ~tick_type(0)
+                              : (tick_type(1) << (SlotBits * Levels)) - 1;
+
+  class handle {
+    friend timer_wheel;
+
+   public:
+    handle() {}
+
+   private:
+    handle(size_type i, uint32_t g) : index(i), generation(g) {}
+
+    size_type index = 0;
+    uint32_t generation = 0;
+  };
+
+  timer_wheel() : buckets(Levels * slotCount) {}
+  timer_wheel(const timer_wheel &) = delete;
+  timer_wheel &operator=(const timer_wheel &) = delete;
+
+  tick_type now() const { return now_; }
+  size_type size() const { return pending_; }
+  bool empty() const { return pending_ == 0; }
+
+  // Runs callback on the advance that reaches now() + delay; a delay of 0
+  // counts as 1. Delays past maxDelay wait in the top level and are placed
+  // again whenever their bucket comes round.
+  handle schedule(tick_type delay, Callback callback) {
+    size_type index;
+    if (free_.empty()) {
+      index = timers.size();
+      timers.push_back(Timer());
+    } else {
+      index = free_.back();
+      free_.pop_back();
+    }
+    Timer &timer = timers[index];
+    timer.deadline = delay > ~tick_type(0) - now_ ? ~tick_type(0)
+                                                  : now_ + (delay ? delay : 1);
+    timer.callback = std::move(callback);
+    place(index);
+    pending_++;
+    return handle(index, timer.generation);
+  }
+
+  bool pending(handle h) const {
+    return h.index < timers.size() && h.generation != 0 &&
+           timers[h.index].generation == h.generation &&
+           timers[h.index].bucket;
+  }
+
+  // Returns false if the timer already fired or was cancelled.
+  bool cancel(handle h) {
+    if (!pending(h)) return false;
+    Timer &timer = timers[h.index];
+    timer.bucket->erase(timer.position);
+    release(h.index);
+    return true;
+  }
+
+  // Moves time forward, firing the due timers tick by tick. Callbacks may
+  // schedule and cancel timers. Returns the number of callbacks run. If a
+  // callback throws, advance stops at the current tick and the timers that
+  // were still due there fire on the next advance.
+  size_type advance(tick_type ticks = 1) {
+    size_type fired = 0;
+    for (; ticks; ticks--) {
+      if (pending_ == 0) {
+        now_ += ticks;
+        break;
+      }
+      now_++;
+      for (size_type level = Levels - 1; level > 0; level--) {
+        if ((now_ & (span(level) - 1)) == 0) cascade(level);
+      }
+      fired += fire(buckets[slotOf(0, now_)]);
+    }
+    return fired;
+  }
+
+ private:
+  using bucket_type = list<size_type>;
+
+  struct Timer {
+    tick_type deadline = 0;
+    Callback callback;
+    bucket_type *bucket = nullptr;
+    typename bucket_type::iterator position = nullptr;
+    uint32_t generation = 1;
+  };
+
+  static tick_type span(size_type level) {
+    return tick_type(1) << (SlotBits * level);
+  }
+
+  static size_type slotOf(size_type level, tick_type tick) {
+    return level * slotCount +
+           ((tick >> (SlotBits * level)) & (slotCount - 1));
+  }
+
+  void place(size_type index) {
+    Timer &timer = timers[index];
+    tick_type delta = timer.deadline - now_;
+    tick_type target = timer.deadline;
+    size_type level = 0;
+    while (level + 1 < Levels && delta >= span(level + 1)) level++;
+    if (level + 1 == Levels && delta > maxDelay) target = now_ + maxDelay;
+    timer.bucket = &buckets[slotOf(level, target)];
+    timer.bucket->push_back(index);
+    timer.position = --timer.bucket->end();
+  }
+
+  void cascade(size_type level) {
+    bucket_type moving;
+    moving.splice(moving.end(), buckets[slotOf(level, now_)]);
+    for (auto i = moving.begin(); i != moving.end(); ++i) place(*i);
+  }
+
+  // Detaches the bucket first so that callbacks can schedule into the
+  // slot being fired without running in this tick.
+  size_type fire(bucket_type &bucket) {
+    bucket_type batch;
+    batch.splice(batch.end(), bucket);
+    for (auto i = batch.begin(); i != batch.end(); ++i) {
+      timers[*i].bucket = &batch;
+      timers[*i].position = i;
+    }
+    size_type fired = 0;
+    while (!batch.empty()) {
+      size_type index = batch.front();
+      batch.pop_front();
+      Callback callback = std::move(timers[index].callback);
+      release(index);
+      try {
+        callback();
+      } catch (...) {
+        requeue(batch);
+        throw;
+      }
+      fired++;
+    }
+    return fired;
+  }
+
+  // Hands the unfired rest of a batch to the next tick's bucket, ahead of
+  // anything already there, so no timer is left pointing at the batch.
+  void requeue(bucket_type &batch) {
+    bucket_type &next = buckets[slotOf(0, now_ + 1)];
+    for (auto i = batch.begin(); i != batch.end(); ++i) {
+      timers[*i].bucket = &next;
+    }
+    next.splice(next.begin(), batch);
+  }
+
+  void release(size_type index) {
+    Timer &timer = timers[index];
+    timer.bucket = nullptr;
+    timer.callback = Callback();
+    if (++timer.generation == 0) timer.generation = 1;
+    free_.push_back(index);
+    pending_--;
+  }
+
+  s21::vector<bucket_type> buckets;
+  s21::vector<Timer> timers;
+  s21::vector<size_type> free_;
+  size_type pending_ = 0;
+  tick_type now_ = 0;
+};
+
+}  // namespace s21
@@ -1,15 +1,101 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "s21_parallel.h"
+#include "s21_vector.h"
 
 enum NodeColor : uint32_t { RED, BLACK };
+
+struct tree_null_update {
+  template <class NodeT>
+  void operator()(NodeT *, const NodeT *) {}
+};
+
+// String keys can cache their first eight bytes, big-endian so that integer
+// order is byte order, along with the key length. Other value types carry
+// nothing.
 template <class value_type>
-struct Node {
+struct node_key_prefix {
+  static constexpr bool enabled = false;
+
+  node_key_prefix() {}
+  template <class Item>
+  explicit node_key_prefix(const Item &) {}
+
+  template <class Item>
+  void cacheKey(const Item &) {}
+};
+
+struct string_key_prefix {
+  static constexpr bool enabled = true;
+
+  uint64_t prefix = 0;
+  size_t length = 0;
+
+  void cacheKey(const std::string &key) {
+    unsigned char bytes[sizeof(prefix)] = {};
+    length = key.size();
+    std::memcpy(bytes, key.data(), std::min(length, sizeof(prefix)));
+    prefix = 0;
+    for (auto byte : bytes) prefix = prefix << 8 | byte;
+  }
+};
+
+template <>
+struct node_key_prefix<std::string> : string_key_prefix {
+  node_key_prefix() {}
+  explicit node_key_prefix(const std::string &key) { cacheKey(key); }
+};
+
+template <class T>
+struct node_key_prefix<std::pair<std::string, T>> : string_key_prefix {
+  node_key_prefix() {}
+  explicit node_key_prefix(const std::pair<std::string, T> &item) {
+    cacheKey(item);
+  }
+
+  void cacheKey(const std::pair<std::string, T> &item) {
+    string_key_prefix::cacheKey(item.first);
+  }
+};
+
+// Whether Compare orders string keys by their bytes, which is what makes the
+// cached prefix usable; wrappers such as map's value_compare expose the key
+// comparator as key_compare.
+template <class Compare, class = void>
+struct key_byte_order
+    : std::bool_constant<std::is_same_v<Compare, std::less<std::string>> ||
+                         std::is_same_v<Compare, std::less<>>> {};
+
+template <class Compare>
+struct key_byte_order<Compare, std::void_t<typename Compare::key_compare>>
+    : key_byte_order<typename Compare::key_compare> {};
+
+// Only nodes of trees whose comparator orders keys by their bytes carry the
+// prefix; a tree with any other comparator would never read it.
+template <class value_type, class Compare>
+using node_prefix_for =
+    std::conditional_t<key_byte_order<Compare>::value,
+                       node_key_prefix<value_type>, node_key_prefix<void>>;
+
+template <class value_type, class Compare>
+struct Node : node_prefix_for<value_type, Compare> {
   Node *left;
   Node *right;
   Node *parent;
   NodeColor color;
+  bool tombstone;
+  // Nodes in the subtree rooted here, tombstones included; 0 for the
+  // sentinel.
+  size_t count;
   value_type item;
 
   Node()
@@ -17,45 +103,295 @@ struct Node {
         right(nullptr),
         parent(nullptr),
         color(BLACK),
+        tombstone(false),
+        count(0),
         item(value_type()) {}
 
   Node(const value_type &v, Node *p)
-      : left(nullptr), right(nullptr), parent(p), color(RED), item(v) {}
+      : node_prefix_for<value_type, Compare>(v),
+        left(nullptr),
+        right(nullptr),
+        parent(p),
+        color(RED),
+        tombstone(false),
+        count(1),
+        item(v) {}
+
+  Node(value_type &&v, Node *p)
+      : node_prefix_for<value_type, Compare>(v),
+        left(nullptr),
+        right(nullptr),
+        parent(p),
+        color(RED),
+        tombstone(false),
+        count(1),
+        item(std::move(v)) {}
 
   bool on_left() { return parent && this == parent->left; }
 
   bool on_right() { return parent && this == parent->right; }
 };
 
-template <class value_type, class Compare, class Allocator>
+// Slots for the items of a small tree. Occupied slots are chained in key
+// order through left and right, ending at the tree's sentinel, so an item
+// stays in its slot until it is erased.
+template <class NodeT, size_t Capacity>
+struct inline_nodes {
+  explicit inline_nodes(NodeT *nil) : first(nil), last(nil) {}
+
+  NodeT *acquire() {
+    size_t i = 0;
+    while (used[i]) i++;
+    used[i] = true;
+    return reinterpret_cast<NodeT *>(storage) + i;
+  }
+
+  void release(NodeT *slot) {
+    used[slot - reinterpret_cast<NodeT *>(storage)] = false;
+  }
+
+  alignas(NodeT) unsigned char storage[Capacity * sizeof(NodeT)];
+  bool used[Capacity] = {};
+  NodeT *first;
+  NodeT *last;
+};
+
+template <class NodeT>
+struct inline_nodes<NodeT, 0> {
+  explicit inline_nodes(NodeT *nil) : first(nil), last(nil) {}
+
+  NodeT *acquire() { return nullptr; }
+  void release(NodeT *) {}
+
+  NodeT *first;
+  NodeT *last;
+};
+
+template <class value_type, class Compare, class Allocator,
+          class NodeUpdate = tree_null_update, size_t InlineCapacity = 0>
 class CTree {
  private:
   using size_type = size_t;
-  using NodeT = Node<value_type>;
-  using pointer = typename std::allocator_traits<Allocator>::pointer;
-  using allocator_traits = std::allocator_traits<Allocator>;
+  using NodeT = Node<value_type, Compare>;
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<NodeT>;
+  using allocator_traits = std::allocator_traits<node_allocator>;
+
+  static constexpr size_type lookupGroupSize = 16;
+  using Probe = node_prefix_for<value_type, Compare>;
+  static constexpr bool usePrefix = Probe::enabled;
 
   static inline NodeT sentinel = NodeT();
   NodeT *root;
   size_type numberOfNodes;
   Compare comp;
-  Allocator allocator;
+  node_allocator allocator;
+  NodeUpdate update;
+  // Contiguous storage produced by relayout(); its slots are released all at
+  // once rather than one node at a time.
+  NodeT *block = nullptr;
+  size_type blockSize = 0;
+  NodeT *finger = &sentinel;
+  bool fingerSearch = false;
+  // While set, up to InlineCapacity items live in inlineStorage and root
+  // stays the sentinel; the first overflow moves them into the tree.
+  bool inlineMode = InlineCapacity != 0;
+  inline_nodes<NodeT, InlineCapacity> inlineStorage{&sentinel};
+  // With a positive fraction, removal only marks nodes as tombstones; once
+  // they make up more than that fraction of the tree it is rebuilt. Slots of
+  // purged nodes are kept in freeSlots for later inserts.
+  double tombstoneFraction = 0;
+  size_type tombstones = 0;
+  s21::vector<NodeT *> freeSlots;
+
+  bool isInline() const { return InlineCapacity != 0 && inlineMode; }
+
+  NodeT *findInlineNode(const value_type &item) {
+    for (auto node = inlineStorage.first; !isNil(node); node = node->right) {
+      if (!comp(node->item, item)) {
+        return comp(item, node->item) ? &sentinel : node;
+      }
+    }
+    return &sentinel;
+  }
+
+  // Links node into the slot chain in front of next, the sentinel meaning
+  // the end.
+  void linkInlineNode(NodeT *node, NodeT *next) {
+    auto prev = isNil(next) ? inlineStorage.last : next->left;
+    node->left = prev;
+    node->right = next;
+    (isNil(prev) ? inlineStorage.first : prev->right) = node;
+    (isNil(next) ? inlineStorage.last : next->left) = node;
+  }
+
+  template <class Item>
+  NodeT *insertInlineNode(Item &&item, NodeT *next) {
+    auto node = inlineStorage.acquire();
+    try {
+      new (node) NodeT(std::forward<Item>(item), nullptr);
+    } catch (...) {
+      inlineStorage.release(node);
+      throw;
+    }
+    linkInlineNode(node, next);
+    numberOfNodes++;
+    return node;
+  }
+
+  NodeT *insertInlineNode(const value_type &item) {
+    auto next = inlineStorage.first;
+    while (!isNil(next) && !comp(item, next->item)) next = next->right;
+    return insertInlineNode(item, next);
+  }
+
+  void removeInlineNode(NodeT *node) {
+    (isNil(node->left) ? inlineStorage.first : node->left->right) =
+        node->right;
+    (isNil(node->right) ? inlineStorage.last : node->right->left) =
+        node->left;
+    node->~NodeT();
+    inlineStorage.release(node);
+    numberOfNodes--;
+  }
+
+  void promoteInlineNodes() {
+    auto node = inlineStorage.first;
+    inlineMode = false;
+    inlineStorage.first = inlineStorage.last = &sentinel;
+    numberOfNodes = 0;
+    while (!isNil(node)) {
+      auto next = node->right;
+      insertNode(node->item);
+      node->~NodeT();
+      inlineStorage.release(node);
+      node = next;
+    }
+  }
+
+  void moveFrom(CTree &other) {
+    root = other.root;
+    numberOfNodes = other.numberOfNodes;
+    fingerSearch = other.fingerSearch;
+    inlineMode = other.inlineMode;
+    if (isInline()) {
+      numberOfNodes = 0;
+      while (other.numberOfNodes) {
+        auto node = other.inlineStorage.first;
+        insertInlineNode(std::move(node->item), &sentinel);
+        other.removeInlineNode(node);
+      }
+    }
+    block = other.block;
+    blockSize = other.blockSize;
+    tombstoneFraction = other.tombstoneFraction;
+    tombstones = other.tombstones;
+    freeSlots.swap(other.freeSlots);
+    other.tombstones = 0;
+    other.root = &sentinel;
+    other.numberOfNodes = 0;
+    other.block = nullptr;
+    other.blockSize = 0;
+    other.finger = &sentinel;
+    other.inlineMode = InlineCapacity != 0;
+  }
+
+  struct SubtreeTask {
+    NodeT *node;
+    bool whole;
+  };
+
+  void splitSubtrees(NodeT *node, size_type depth,
+                     s21::vector<SubtreeTask> &out) const {
+    if (isNil(node)) {
+      return;
+    }
+    if (depth == 0) {
+      out.push_back({node, true});
+      return;
+    }
+    splitSubtrees(node->left, depth - 1, out);
+    out.push_back({node, false});
+    splitSubtrees(node->right, depth - 1, out);
+  }
+
+  template <class Visit>
+  void visitSubtree(NodeT *node, Visit &visit) const {
+    if (!isNil(node)) {
+      visitSubtree(node->left, visit);
+      if (!node->tombstone) visit(node->item);
+      visitSubtree(node->right, visit);
+    }
+  }
+
+  // Orders the probed item against node->item from the cached prefixes
+  // alone: -1, 0 or 1, or 2 when the full keys have to decide.
+  int prefixOrder(const Probe &probe, NodeT *node) const {
+    if constexpr (usePrefix) {
+      if (probe.prefix != node->prefix) {
+        return probe.prefix < node->prefix ? -1 : 1;
+      }
+      if (probe.length <= sizeof(probe.prefix) &&
+          node->length <= sizeof(node->prefix)) {
+        return (probe.length > node->length) - (probe.length < node->length);
+      }
+    }
+    return 2;
+  }
+
+  bool before(const Probe &probe, const value_type &item, NodeT *node) {
+    auto order = prefixOrder(probe, node);
+    return order != 2 ? order < 0 : comp(item, node->item);
+  }
+
+  bool after(const Probe &probe, const value_type &item, NodeT *node) {
+    auto order = prefixOrder(probe, node);
+    return order != 2 ? order > 0 : comp(node->item, item);
+  }
 
   NodeT *findNode(NodeT *root, const value_type &item) {
+    Probe probe(item);
     auto node = root;
     while (!isNil(node)) {
-      if (!comp(item, node->item) && !comp(node->item, item)) {
-        return node;
+      if (before(probe, item, node)) {
+        node = node->left;
+      } else if (after(probe, item, node)) {
+        node = node->right;
       } else {
-        node = comp(item, node->item) ? node->left : node->right;
+        return node;
       }
     }
     return &sentinel;
   }
 
+  // Climbs from the last accessed node to the lowest ancestor whose subtree
+  // must contain item, so nearby lookups skip most of the descent.
+  NodeT *fingerStart(const value_type &item) {
+    auto node = finger;
+    if (isNil(node)) {
+      return root;
+    }
+    if (comp(item, node->item)) {
+      while (node->parent) {
+        if (node->on_right() && !comp(item, node->parent->item)) {
+          return node->parent;
+        }
+        node = node->parent;
+      }
+    } else if (comp(node->item, item)) {
+      while (node->parent) {
+        if (node->on_left() && !comp(node->parent->item, item)) {
+          return node->parent;
+        }
+        node = node->parent;
+      }
+    }
+    return node;
+  }
+
   NodeT *node_min(NodeT *root) const {
     auto node = root;
-    while (!isNil(node->left)) {
+    while (!isNil(node) && !isNil(node->left)) {
       node = node->left;
     }
     return node;
@@ -63,18 +399,348 @@ class CTree {
 
   NodeT *node_max(NodeT *root) const {
     auto node = root;
-    while (!isNil(node->right)) {
+    while (!isNil(node) && !isNil(node->right)) {
       node = node->right;
     }
     return node;
   }
 
+  NodeT *successor(NodeT *node) const {
+    if (!isNil(node->right)) {
+      return node_min(node->right);
+    }
+    while (node->on_right()) {
+      node = node->parent;
+    }
+    return node != root ? node->parent : const_cast<NodeT *>(&sentinel);
+  }
+
+  NodeT *predecessor(NodeT *node) const {
+    if (!isNil(node->left)) {
+      return node_max(node->left);
+    }
+    while (node->on_left()) {
+      node = node->parent;
+    }
+    return node != root ? node->parent : const_cast<NodeT *>(&sentinel);
+  }
+
+  NodeT *skipForward(NodeT *node) const {
+    while (tombstones && !isNil(node) && node->tombstone) {
+      node = successor(node);
+    }
+    return node;
+  }
+
+  NodeT *skipBackward(NodeT *node) const {
+    while (tombstones && !isNil(node) && node->tombstone) {
+      node = predecessor(node);
+    }
+    return node;
+  }
+
+  NodeT *rawLowerBound(const value_type &item) {
+    Probe probe(item);
+    NodeT *result = &sentinel;
+    for (auto node = root; !isNil(node);) {
+      if (!after(probe, item, node)) {
+        result = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return result;
+  }
+
+  NodeT *findLiveNode(const value_type &item) {
+    auto node = skipForward(rawLowerBound(item));
+    return isNil(node) || comp(item, node->item) ? &sentinel : node;
+  }
+
+  // A tombstone next to the insert position can take the new item without
+  // breaking the order: the raw lower bound is not less than item and its
+  // predecessor is less than it.
+  NodeT *reviveTombstone(const value_type &item) {
+    auto next = rawLowerBound(item);
+    auto prev = isNil(next) ? node_max(root) : predecessor(next);
+    auto node = !isNil(next) && next->tombstone ? next : prev;
+    if (isNil(node) || !node->tombstone) {
+      return nullptr;
+    }
+    node->item = item;
+    node->cacheKey(node->item);
+    node->tombstone = false;
+    tombstones--;
+    numberOfNodes++;
+    updatePath(node);
+    if (fingerSearch) finger = node;
+    return node;
+  }
+
+  void buryNode(NodeT *node) {
+    node->tombstone = true;
+    tombstones++;
+    numberOfNodes--;
+    if (finger == node) finger = &sentinel;
+    if (numberOfNodes == 0 ||
+        tombstones > tombstoneFraction * (numberOfNodes + tombstones)) {
+      purgeTombstones();
+    }
+  }
+
+  void collectLive(NodeT *node, s21::vector<NodeT *> &live) {
+    if (isNil(node)) {
+      return;
+    }
+    auto right = node->right;
+    collectLive(node->left, live);
+    if (!node->tombstone) {
+      live.push_back(node);
+    } else {
+      allocator_traits::destroy(allocator, node);
+      if (!inBlock(node)) freeSlots.push_back(node);
+    }
+    collectLive(right, live);
+  }
+
+  // Links live[lo, hi) into a tree split at the midpoints. Its nil links sit
+  // at depth maxDepth or one below, so colouring only the deepest level red
+  // keeps every black height equal.
+  NodeT *buildBalanced(s21::vector<NodeT *> &live, size_type lo, size_type hi,
+                       size_type depth, size_type maxDepth, NodeT *parent) {
+    if (lo == hi) {
+      return &sentinel;
+    }
+    auto mid = lo + (hi - lo) / 2;
+    auto node = live[mid];
+    node->parent = parent;
+    node->color = depth == maxDepth ? RED : BLACK;
+    node->left = buildBalanced(live, lo, mid, depth + 1, maxDepth, node);
+    node->right = buildBalanced(live, mid + 1, hi, depth + 1, maxDepth, node);
+    updateNode(node);
+    return node;
+  }
+
+  // Live nodes keep their addresses, so iterators to them stay valid.
+  void purgeTombstones() {
+    if (!tombstones) {
+      return;
+    }
+    s21::vector<NodeT *> live;
+    live.reserve(numberOfNodes);
+    collectLive(root, live);
+    tombstones = 0;
+    finger = &sentinel;
+    size_type depth = 0;
+    while ((size_type(2) << depth) <= live.size()) depth++;
+    root = buildBalanced(live, 0, live.size(), 0, depth, nullptr);
+    root->color = BLACK;
+    if (isNil(root)) {
+      releaseBlock();
+      inlineMode = InlineCapacity != 0;
+    }
+  }
+
+  NodeT *allocateNode() {
+    if (freeSlots.empty()) {
+      return allocator_traits::allocate(allocator, 1);
+    }
+    auto node = freeSlots.back();
+    freeSlots.pop_back();
+    return node;
+  }
+
+  void releaseFreeSlots() {
+    for (auto node : freeSlots) {
+      allocator_traits::deallocate(allocator, node, 1);
+    }
+    freeSlots.clear();
+  }
+
+  bool inBlock(NodeT *node) const {
+    std::less<NodeT *> less;
+    return block && !less(node, block) && less(node, block + blockSize);
+  }
+
+  void freeNode(NodeT *node) {
+    allocator_traits::destroy(allocator, node);
+    if (!inBlock(node)) {
+      allocator_traits::deallocate(allocator, node, 1);
+    }
+  }
+
+  void releaseBlock() {
+    if (block) {
+      allocator_traits::deallocate(allocator, block, blockSize);
+      block = nullptr;
+      blockSize = 0;
+    }
+  }
+
   void removeAllNodes(NodeT *root) {
     if (!isNil(root)) {
       removeAllNodes(root->left);
       removeAllNodes(root->right);
-      allocator_traits::deallocate(allocator, reinterpret_cast<pointer>(root),
-                                   sizeof(NodeT));
+      freeNode(root);
+    }
+  }
+
+  // Moves the subtree into storage handed out by place() in key order; parent
+  // links are filled in by fixParents once every node has its final address.
+  template <class Place>
+  NodeT *relocate(NodeT *node, Place &place) {
+    if (isNil(node)) {
+      return &sentinel;
+    }
+    auto left = relocate(node->left, place);
+    auto copy = place();
+    allocator_traits::construct(allocator, copy, std::move(node->item),
+                                nullptr);
+    copy->color = node->color;
+    copy->count = node->count;
+    copy->left = left;
+    copy->right = relocate(node->right, place);
+    return copy;
+  }
+
+  void fixParents(NodeT *node) {
+    if (!isNil(node->left)) {
+      node->left->parent = node;
+      fixParents(node->left);
+    }
+    if (!isNil(node->right)) {
+      node->right->parent = node;
+      fixParents(node->right);
+    }
+  }
+
+  // Gives every node its own allocation again, so nodes can be handed over
+  // to another tree.
+  void releaseLayout() {
+    if (!block) {
+      return;
+    }
+    auto place = [&] { return allocator_traits::allocate(allocator, 1); };
+    auto newRoot = relocate(root, place);
+    removeAllNodes(root);
+    releaseBlock();
+    root = newRoot;
+    fixParents(root);
+    finger = &sentinel;
+  }
+
+  size_type blackHeight(NodeT *node) const {
+    size_type height = 0;
+    for (; !isNil(node); node = node->left) {
+      if (node->color == BLACK) height++;
+    }
+    return height;
+  }
+
+  // A subtree cut loose from its parent, with the number of black nodes on
+  // each of its paths down to a leaf.
+  struct Subtree {
+    NodeT *root;
+    size_type height;
+  };
+
+  // Blackening a red root adds one to the black height.
+  NodeT *detachSubtree(Subtree &tree) {
+    if (!isNil(tree.root)) {
+      tree.root->parent = nullptr;
+      if (tree.root->color == RED) tree.height++;
+      tree.root->color = BLACK;
+    }
+    return tree.root;
+  }
+
+  // Joins two subtrees around mid, where left < mid < right, by hanging mid
+  // at the point of the taller tree's spine whose black height matches the
+  // shorter tree, then repairing the red-red violation. The spine walked
+  // down, the counts refreshed back up and the fixup are all proportional
+  // to the black-height difference.
+  Subtree joinSubtrees(Subtree left, NodeT *mid, Subtree right) {
+    detachSubtree(left);
+    detachSubtree(right);
+    auto leftHeight = left.height, rightHeight = right.height;
+    NodeT *parent = nullptr;
+    mid->color = RED;
+    if (leftHeight >= rightHeight) {
+      auto node = left.root;
+      for (; node->color != BLACK || leftHeight != rightHeight;
+           node = node->right) {
+        if (node->color == BLACK) leftHeight--;
+        parent = node;
+      }
+      mid->left = node;
+      mid->right = right.root;
+      root = parent ? left.root : mid;
+      if (parent) parent->right = mid;
+    } else {
+      auto node = right.root;
+      for (; node->color != BLACK || leftHeight != rightHeight;
+           node = node->left) {
+        if (node->color == BLACK) rightHeight--;
+        parent = node;
+      }
+      mid->left = left.root;
+      mid->right = node;
+      root = parent ? right.root : mid;
+      if (parent) parent->left = mid;
+    }
+    mid->parent = parent;
+    if (!isNil(mid->left)) mid->left->parent = mid;
+    if (!isNil(mid->right)) mid->right->parent = mid;
+    for (auto node = mid; node; node = node->parent) updateNode(node);
+    auto height = std::max(left.height, right.height);
+    if (insertFixupNode(mid)) height++;
+    return {root, height};
+  }
+
+  // Splits the subtree into the nodes ordered before item and the rest. The
+  // pieces joined on the way back up grow in black height, so the joins
+  // telescope to O(log n) in total.
+  void splitSubtree(Subtree tree, const value_type &item, Subtree &less,
+                    Subtree &rest) {
+    auto node = tree.root;
+    if (isNil(node)) {
+      less = rest = {node, 0};
+      return;
+    }
+    Subtree left{node->left, tree.height - (node->color == BLACK)};
+    Subtree right{node->right, left.height};
+    node->left = node->right = &sentinel;
+    Subtree middle;
+    if (!comp(node->item, item)) {
+      splitSubtree(left, item, less, middle);
+      rest = joinSubtrees(middle, node, right);
+    } else {
+      splitSubtree(right, item, middle, rest);
+      less = joinSubtrees(left, node, middle);
+    }
+  }
+
+  // left and right are whole trees, so their roots are already black.
+  void joinTree(NodeT *left, NodeT *right) {
+    auto mid = node_max(left);
+    root = left;
+    unlinkNode(mid);
+    mid->left = mid->right = &sentinel;
+    joinSubtrees({root, blackHeight(root)}, mid,
+                 {right, blackHeight(right)});
+  }
+
+  void updateNode(NodeT *x) {
+    x->count = 1 + x->left->count + x->right->count;
+    if constexpr (!std::is_same_v<NodeUpdate, tree_null_update>) {
+      update(x, &sentinel);
+    }
+  }
+
+  void updatePath(NodeT *x) {
+    if constexpr (!std::is_same_v<NodeUpdate, tree_null_update>) {
+      for (; x && !isNil(x); x = x->parent) update(x, &sentinel);
     }
   }
 
@@ -93,6 +759,8 @@ class CTree {
     }
     y->left = x;
     if (!isNil(x)) x->parent = y;
+    updateNode(x);
+    updateNode(y);
   }
 
   void rotate_right(NodeT *x) {
@@ -110,9 +778,13 @@ class CTree {
     }
     y->right = x;
     if (!isNil(x)) x->parent = y;
+    updateNode(x);
+    updateNode(y);
   }
 
-  void insertFixupNode(NodeT *x) {
+  // Returns whether the root had to be blackened, which makes the tree one
+  // black node taller.
+  bool insertFixupNode(NodeT *x) {
     while (x != root && x->parent->color == RED) {
       if (x->parent == x->parent->parent->left) {
         auto y = x->parent->parent->right;
@@ -148,7 +820,9 @@ class CTree {
         }
       }
     }
+    bool grew = root->color == RED;
     root->color = BLACK;
+    return grew;
   }
 
   void deleteFixupNode(NodeT *x) {
@@ -211,43 +885,95 @@ class CTree {
       : root(&sentinel),
         numberOfNodes(0),
         comp(Compare()),
-        allocator(Allocator()) {}
+        allocator(node_allocator()) {}
+
+  CTree(CTree &&other)
+      : comp(std::move(other.comp)), allocator(std::move(other.allocator)) {
+    moveFrom(other);
+  }
+
+  CTree &operator=(CTree &&other) {
+    if (this != &other) {
+      removeAllNodes();
+      comp = std::move(other.comp);
+      allocator = std::move(other.allocator);
+      moveFrom(other);
+    }
+    return *this;
+  }
 
   ~CTree() { removeAllNodes(); }
 
   NodeT *insertNode(const value_type &item) {
+    if (isInline()) {
+      if (numberOfNodes < InlineCapacity) {
+        return insertInlineNode(item);
+      }
+      promoteInlineNodes();
+    }
+    if (tombstones) {
+      if (auto revived = reviveTombstone(item)) return revived;
+    }
+    Probe probe(item);
     NodeT *node = root;
     NodeT *parent = nullptr;
+    bool left = false;
     while (!isNil(node)) {
       parent = node;
-      node = comp(item, node->item) ? node->left : node->right;
+      left = before(probe, item, node);
+      node = left ? node->left : node->right;
     }
-    node = reinterpret_cast<NodeT *>(allocator_traits::allocate(
-        allocator, sizeof(NodeT)));  // NodeT(item, parent);
+    node = allocateNode();
     allocator_traits::construct(allocator, node, item, parent);
     node->left = node->right = &sentinel;
+    for (auto above = parent; above; above = above->parent) above->count++;
 
     if (nullptr == parent) {
       root = node;
     } else {
-      if (comp(item, parent->item)) {
+      if (left) {
         parent->left = node;
       } else {
         parent->right = node;
       }
     }
+    updatePath(node);
     insertFixupNode(node);
     numberOfNodes++;
+    if (fingerSearch) finger = node;
     return node;
   }
 
   void removeNode(const value_type &item) {
-    NodeT *x, *y;
-
     auto node = findNode(item);
-    if (isNil(node)) {
+    if (!isNil(node)) {
+      removeNode(node);
+    }
+  }
+
+  void removeNode(NodeT *node) {
+    if (isInline()) {
+      removeInlineNode(node);
       return;
     }
+    if (tombstoneFraction > 0) {
+      buryNode(node);
+      return;
+    }
+    freeNode(unlinkNode(node));
+    numberOfNodes--;
+    if (isNil(root)) {
+      releaseBlock();
+      numberOfNodes = 0;
+      inlineMode = InlineCapacity != 0;
+    }
+  }
+
+  // Takes node out of the tree and rebalances it. Returns the node that was
+  // physically unlinked: node itself, or its successor whose item was moved
+  // into node.
+  NodeT *unlinkNode(NodeT *node) {
+    NodeT *x, *y;
 
     if (isNil(node->left) || isNil(node->right)) {
       y = node;
@@ -275,18 +1001,136 @@ class CTree {
       root = x;
     }
     if (y != node) {
-      node->item = y->item;
+      node->item = std::move(y->item);
+      node->cacheKey(node->item);
+    }
+    for (auto parent = y->parent; parent; parent = parent->parent) {
+      parent->count--;
     }
+    updatePath(x->parent);
 
     if (y->color == BLACK) {
       deleteFixupNode(x);
     }
-    allocator_traits::deallocate(allocator, reinterpret_cast<pointer>(y),
-                                 sizeof(NodeT));
-    numberOfNodes--;
+    if (finger == y) {
+      finger = y != node ? node : &sentinel;
+    }
+    return y;
   }
 
-  NodeT *getFirstNode() const { return node_min(root); }
+  void relayout() {
+    purgeTombstones();
+    if (isInline() || isNil(root)) {
+      return;
+    }
+    auto size = getNumberOfNodes();
+    auto newBlock = allocator_traits::allocate(allocator, size);
+    auto slot = newBlock;
+    auto place = [&] { return slot++; };
+    auto newRoot = relocate(root, place);
+    removeAllNodes(root);
+    releaseBlock();
+    block = newBlock;
+    blockSize = size;
+    root = newRoot;
+    fixParents(root);
+    finger = &sentinel;
+  }
+
+  // Moves the items not ordered before item into the empty tree `rest` in
+  // O(log n); subtree counts give both sizes. Pending tombstones are purged
+  // and a compacted tree gives its nodes separate allocations first, since
+  // neither tombstones nor the shared block can be divided along the cut;
+  // both are O(n) passes.
+  void splitTree(const value_type &item, CTree &rest) {
+    if (isInline()) {
+      for (auto node = lowerBoundNode(item); !isNil(node);
+           node = lowerBoundNode(item)) {
+        rest.insertNode(node->item);
+        removeNode(node);
+      }
+      return;
+    }
+    purgeTombstones();
+    releaseLayout();
+    Subtree less, greater;
+    splitSubtree({root, blackHeight(root)}, item, less, greater);
+    root = less.root;
+    rest.root = greater.root;
+    numberOfNodes = root->count;
+    rest.numberOfNodes = rest.root->count;
+    rest.inlineMode = isNil(rest.root) && InlineCapacity != 0;
+    inlineMode = isNil(root) && InlineCapacity != 0;
+    finger = &sentinel;
+  }
+
+  // Moves every item of other into this tree in O(log n); the key ranges of
+  // the two trees must not interleave. Tombstones move along with the live
+  // nodes. If both trees are compacted, other's nodes are first given
+  // separate allocations, an O(n) pass; otherwise a block changes owner
+  // with its nodes.
+  void joinTree(CTree &other) {
+    if (isNil(other.getFirstNode())) {
+      return;
+    }
+    if (isNil(getFirstNode())) {
+      std::swap(*this, other);
+      return;
+    }
+    bool before = comp(getLastNode()->item, other.getFirstNode()->item);
+    if (!before && !comp(other.getLastNode()->item, getFirstNode()->item)) {
+      throw std::invalid_argument("trees_overlap");
+    }
+    if (other.isInline() || isInline()) {
+      if (isInline() && !other.isInline()) {
+        std::swap(*this, other);
+      }
+      for (auto node = other.getFirstNode(); !other.isNil(node);
+           node = other.getFirstNode()) {
+        insertNode(node->item);
+        other.removeNode(node);
+      }
+      return;
+    }
+    if (tombstoneFraction <= 0) {
+      other.purgeTombstones();
+    }
+    if (block) {
+      other.releaseLayout();
+    } else {
+      std::swap(block, other.block);
+      std::swap(blockSize, other.blockSize);
+    }
+    if (before) {
+      joinTree(root, other.root);
+    } else {
+      joinTree(other.root, root);
+    }
+    numberOfNodes += other.numberOfNodes;
+    tombstones += other.tombstones;
+    finger = &sentinel;
+    other.root = &sentinel;
+    other.numberOfNodes = 0;
+    other.tombstones = 0;
+    other.finger = &sentinel;
+    other.inlineMode = InlineCapacity != 0;
+  }
+
+  NodeT *getRootNode() const { return root; }
+
+  NodeT *getFirstNode() const {
+    if (isInline()) {
+      return inlineStorage.first;
+    }
+    return skipForward(node_min(root));
+  }
+
+  NodeT *getLastNode() const {
+    if (isInline()) {
+      return inlineStorage.last;
+    }
+    return skipBackward(node_max(root));
+  }
 
   NodeT *getSentinelNode() const { return const_cast<NodeT *>(&sentinel); }
 
@@ -294,41 +1138,212 @@ class CTree {
     if (isNil(node)) {
       return const_cast<NodeT *>(&sentinel);
     }
-    if (!isNil(node->right)) {
-      return node_min(node->right);
-    } else {
-      while (node->on_right()) {
-        node = node->parent;
-      }
-      return node != root ? node->parent : const_cast<NodeT *>(&sentinel);
+    if (isInline()) {
+      return node->right;
     }
+    return skipForward(successor(node));
   }
 
   NodeT *prevNode(NodeT *node) const {
     if (isNil(node)) {
       return const_cast<NodeT *>(&sentinel);
     }
-    if (!isNil(node->left)) {
-      return node_max(node->left);
-    } else {
-      while (node->on_left()) {
-        node = node->parent;
+    if (isInline()) {
+      return node->left;
+    }
+    return skipBackward(predecessor(node));
+  }
+
+  NodeT *lowerBoundNode(const value_type &item) {
+    if (isInline()) {
+      auto node = inlineStorage.first;
+      while (!isNil(node) && comp(node->item, item)) node = node->right;
+      return node;
+    }
+    return skipForward(rawLowerBound(item));
+  }
+
+  NodeT *upperBoundNode(const value_type &item) {
+    NodeT *result = &sentinel;
+    if (isInline()) {
+      auto node = inlineStorage.first;
+      while (!isNil(node) && !comp(item, node->item)) node = node->right;
+      return node;
+    }
+    Probe probe(item);
+    for (auto node = root; !isNil(node);) {
+      if (before(probe, item, node)) {
+        result = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return skipForward(result);
+  }
+
+  NodeT *findNode(const value_type &item) {
+    if (isInline()) {
+      return findInlineNode(item);
+    }
+    if (tombstones) {
+      return findLiveNode(item);
+    }
+    if (!fingerSearch) {
+      return findNode(root, item);
+    }
+    auto node = findNode(fingerStart(item), item);
+    if (!isNil(node)) finger = node;
+    return node;
+  }
+
+  // Cuts the tree at the shallowest depth with at least `parts` subtrees.
+  // The result lists, in key order, those subtrees and the single nodes above
+  // them, so the pieces can be traversed independently.
+  s21::vector<SubtreeTask> splitSubtrees(size_type parts) const {
+    s21::vector<SubtreeTask> out;
+    if (isInline()) {
+      for (auto node = inlineStorage.first; !isNil(node); node = node->right) {
+        out.push_back({node, false});
       }
-      return node != root ? node->parent : const_cast<NodeT *>(&sentinel);
+      return out;
+    }
+    size_type depth = 0;
+    while ((size_type(1) << depth) < parts) depth++;
+    splitSubtrees(root, depth, out);
+    return out;
+  }
+
+  template <class Visit>
+  void visitSubtree(const SubtreeTask &task, Visit visit) const {
+    if (task.whole) {
+      visitSubtree(task.node, visit);
+    } else if (!task.node->tombstone) {
+      visit(task.node->item);
+    }
+  }
+
+  // Visits every live item once, in about four subtree tasks per hardware
+  // thread run on the parallel pool.
+  template <class Function>
+  void parallelForEach(Function fn) {
+    auto threads = s21::parallel_threads();
+    auto tasks = splitSubtrees(4 * threads);
+    s21::parallel_run(tasks.size(), threads,
+                      [&](size_type i) { visitSubtree(tasks[i], fn); });
+  }
+
+  // Folds each subtree task into a partial result with op(R, item), then
+  // folds init and the partials in key order with combine(R, R), so init
+  // is applied exactly once. A task starts from its first item when items
+  // convert to R and from R() otherwise, which must then be an identity of
+  // op. Passing op as combine too therefore needs items that convert to R.
+  template <class R, class Op, class Combine>
+  R parallelReduce(R init, Op op, Combine combine) {
+    auto threads = s21::parallel_threads();
+    auto tasks = splitSubtrees(4 * threads);
+    s21::vector<std::optional<R>> partials(tasks.size());
+    s21::parallel_run(tasks.size(), threads, [&](size_type i) {
+      std::optional<R> acc;
+      visitSubtree(tasks[i], [&](value_type &item) {
+        if (acc) {
+          acc = op(std::move(*acc), item);
+        } else if constexpr (std::is_convertible_v<value_type &, R>) {
+          acc.emplace(item);
+        } else {
+          acc = op(R(), item);
+        }
+      });
+      partials[i] = std::move(acc);
+    });
+    for (auto &partial : partials) {
+      if (partial) init = combine(std::move(init), std::move(*partial));
     }
+    return init;
+  }
+
+  // Erase leaves tombstones until they exceed the given fraction of the
+  // nodes; 0 switches back to eager erase.
+  void setTombstoneFraction(double fraction) {
+    tombstoneFraction = fraction;
+    if (fraction <= 0) purgeTombstones();
+  }
+
+  void setFingerSearch(bool enabled) {
+    fingerSearch = enabled;
+    finger = &sentinel;
   }
 
-  NodeT *findNode(const value_type &item) { return findNode(root, item); }
+  // Runs up to lookupGroupSize descents in lock-step so their cache misses
+  // overlap, prefetching each lane's next child one level ahead. visit gets
+  // the found node (or the sentinel) for every probe, in input order.
+  template <class InputIt, class MakeItem, class Visit>
+  void findNodes(InputIt first, InputIt last, MakeItem make, Visit visit) {
+    if (isInline()) {
+      for (; first != last; ++first) visit(findInlineNode(make(*first)));
+      return;
+    }
+    value_type items[lookupGroupSize];
+    Probe probes[lookupGroupSize];
+    NodeT *nodes[lookupGroupSize];
+    bool done[lookupGroupSize];
+    while (first != last) {
+      size_type count = 0;
+      for (; count < lookupGroupSize && first != last; ++count, ++first) {
+        items[count] = make(*first);
+        probes[count] = Probe(items[count]);
+        nodes[count] = root;
+        done[count] = isNil(root);
+      }
+      for (size_type active = count; active != 0;) {
+        active = 0;
+        for (size_type i = 0; i < count; i++) {
+          if (done[i]) continue;
+          auto node = nodes[i];
+          if (before(probes[i], items[i], node)) {
+            node = node->left;
+          } else if (after(probes[i], items[i], node)) {
+            node = node->right;
+          } else {
+            done[i] = true;
+            continue;
+          }
+          nodes[i] = node;
+          if (isNil(node)) {
+            done[i] = true;
+          } else {
+            __builtin_prefetch(node);
+            active++;
+          }
+        }
+      }
+      for (size_type i = 0; i < count; i++) {
+        visit(tombstones && nodes[i]->tombstone ? findLiveNode(items[i])
+                                                : nodes[i]);
+      }
+    }
+  }
 
   void removeAllNodes() {
+    while (isInline() && numberOfNodes) {
+      removeInlineNode(inlineStorage.first);
+    }
+    inlineMode = InlineCapacity != 0;
     removeAllNodes(root);
+    releaseBlock();
+    releaseFreeSlots();
+    root = &sentinel;
     numberOfNodes = 0;
+    tombstones = 0;
+    finger = &sentinel;
   }
 
   size_type getNumberOfNodes() { return numberOfNodes; }
   size_type getNumberOfNodes(const value_type &item) {
     size_type count = 0;
-    auto node = findNode(root, item);
+    auto node = isInline()     ? findInlineNode(item)
+                : tombstones ? findLiveNode(item)
+                             : findNode(root, item);
 
     while (!isNil(node)) {
       count++;
@@ -345,11 +1360,13 @@ class CTree {
   bool isNil(NodeT *node) const { return node == &sentinel; }
 };
 
-template <class value_type, class Compare, class Allocator>
+template <class value_type, class Compare, class Allocator,
+          class NodeUpdate = tree_null_update, size_t InlineCapacity = 0>
 class CTree_iterator {
   using reference = value_type &;
-  using NodeT = Node<value_type>;
-  using Tree = CTree<value_type, Compare, Allocator>;
+  using NodeT = Node<value_type, Compare>;
+  using Tree =
+      CTree<value_type, Compare, Allocator, NodeUpdate, InlineCapacity>;
 
  private:
   const Tree *tree;
@@ -390,4 +1407,6 @@ class CTree_iterator {
   }
 
   reference operator*() { return node->item; }
+
+  NodeT *getNode() const { return node; }
 };
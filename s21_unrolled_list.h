@@ -0,0 +1,333 @@
+#ifndef _SRC_S21_UNROLLED_LIST_H_
+#define _SRC_S21_UNROLLED_LIST_H_
+
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// A doubly linked ring of chunks, each holding up to chunkCapacity elements
+// contiguously. A full chunk splits in half on insert, and a chunk that
+// drops below half full absorbs its successor when both fit in three
+// quarters of a chunk. Insert and erase invalidate iterators into the
+// chunks they touch; splice only splits the chunk at pos.
+template <class T, std::size_t ChunkBytes = 256>
+class unrolled_list {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  static constexpr size_type chunkCapacity =
+      ChunkBytes / sizeof(T) > 1 ? ChunkBytes / sizeof(T) : 2;
+
+ private:
+  struct ChunkBase {
+    ChunkBase *prev = this;
+    ChunkBase *next = this;
+    size_type count = 0;
+  };
+
+  struct Chunk : ChunkBase {
+    alignas(T) unsigned char storage[chunkCapacity * sizeof(T)];
+
+    T *data() { return reinterpret_cast<T *>(storage); }
+  };
+
+  static T *data(ChunkBase *chunk) {
+    return static_cast<Chunk *>(chunk)->data();
+  }
+
+  template <bool IsConst>
+  class common_iterator {
+    friend unrolled_list;
+
+   public:
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+
+    common_iterator(ChunkBase *c, size_type i) : chunk(c), index(i) {}
+
+    operator common_iterator<true>() const {
+      return common_iterator<true>(chunk, index);
+    }
+
+    reference operator*() const { return data(chunk)[index]; }
+
+    common_iterator &operator++() {
+      if (++index == chunk->count) {
+        chunk = chunk->next;
+        index = 0;
+      }
+      return *this;
+    }
+
+    common_iterator &operator--() {
+      if (index == 0) {
+        chunk = chunk->prev;
+        index = chunk->count;
+      }
+      index--;
+      return *this;
+    }
+
+    common_iterator operator++(int) {
+      auto iter = *this;
+      ++(*this);
+      return iter;
+    }
+
+    common_iterator operator--(int) {
+      auto iter = *this;
+      --(*this);
+      return iter;
+    }
+
+    bool operator==(const common_iterator &other) const {
+      return chunk == other.chunk && index == other.index;
+    }
+    bool operator!=(const common_iterator &other) const {
+      return !(*this == other);
+    }
+
+   private:
+    ChunkBase *chunk;
+    size_type index;
+  };
+
+ public:
+  using iterator = common_iterator<false>;
+  using const_iterator = common_iterator<true>;
+
+  unrolled_list() {}
+
+  explicit unrolled_list(size_type n) {
+    for (size_type k = 0; k < n; k++) push_back(value_type{});
+  }
+
+  unrolled_list(std::initializer_list<value_type> const &items) {
+    for (const auto &item : items) push_back(item);
+  }
+
+  unrolled_list(const unrolled_list &other) {
+    for (const auto &item : other) push_back(item);
+  }
+
+  unrolled_list(unrolled_list &&other) { swap(other); }
+
+  unrolled_list &operator=(unrolled_list &&other) {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  unrolled_list &operator=(const unrolled_list &other) {
+    if (this != &other) {
+      unrolled_list copy(other);
+      clear();
+      swap(copy);
+    }
+    return *this;
+  }
+
+  ~unrolled_list() { clear(); }
+
+  iterator begin() { return iterator(sentinel.next, 0); }
+  iterator end() { return iterator(&sentinel, 0); }
+  const_iterator begin() const {
+    return const_iterator(sentinel.next, 0);
+  }
+  const_iterator end() const {
+    return const_iterator(const_cast<ChunkBase *>(&sentinel), 0);
+  }
+
+  reference front() { return data(sentinel.next)[0]; }
+  reference back() { return data(sentinel.prev)[sentinel.prev->count - 1]; }
+  const_reference front() const { return data(sentinel.next)[0]; }
+  const_reference back() const {
+    return data(sentinel.prev)[sentinel.prev->count - 1];
+  }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type max_size() const {
+    return std::numeric_limits<std::ptrdiff_t>().max() / sizeof(T);
+  }
+
+  void clear() {
+    for (ChunkBase *chunk = sentinel.next; chunk != &sentinel;) {
+      ChunkBase *next = chunk->next;
+      for (size_type i = 0; i < chunk->count; i++) data(chunk)[i].~T();
+      delete static_cast<Chunk *>(chunk);
+      chunk = next;
+    }
+    sentinel.next = sentinel.prev = &sentinel;
+    size_ = 0;
+  }
+
+  void push_back(const value_type &value) { insert(end(), value); }
+  void push_back(value_type &&value) { insert(end(), std::move(value)); }
+  void push_front(const value_type &value) { insert(begin(), value); }
+  void push_front(value_type &&value) { insert(begin(), std::move(value)); }
+  void pop_back() { erase(--end()); }
+  void pop_front() { erase(begin()); }
+
+  // value is taken before any element moves, so it may be an element of
+  // this list.
+  iterator insert(iterator pos, const value_type &value) {
+    value_type item(value);
+    return place(pos, item);
+  }
+
+  iterator insert(iterator pos, value_type &&value) {
+    value_type item(std::move(value));
+    return place(pos, item);
+  }
+
+  // Returns the iterator to the element after the erased one.
+  iterator erase(iterator pos) {
+    ChunkBase *chunk = pos.chunk;
+    size_type index = pos.index;
+    T *items = data(chunk);
+    for (size_type i = index; i + 1 < chunk->count; i++) {
+      items[i] = std::move(items[i + 1]);
+    }
+    items[--chunk->count].~T();
+    size_--;
+    if (chunk->count == 0) {
+      ChunkBase *next = chunk->next;
+      unlinkChunk(chunk);
+      return iterator(next, 0);
+    }
+    ChunkBase *next = chunk->next;
+    if (next != &sentinel && chunk->count < chunkCapacity / 2 &&
+        chunk->count + next->count <= chunkCapacity * 3 / 4) {
+      moveItems(next, 0, chunk);
+      unlinkChunk(next);
+    }
+    return index < chunk->count ? iterator(chunk, index)
+                                : iterator(chunk->next, 0);
+  }
+
+  // Moves every element of other in front of pos. The chunks of other are
+  // relinked as they are; only the chunk holding pos is split when pos is
+  // not at a chunk boundary.
+  void splice(const_iterator pos, unrolled_list &other) {
+    if (this == &other || other.empty()) return;
+    ChunkBase *chunk = pos.chunk;
+    if (pos.index != 0) chunk = splitChunk(chunk, pos.index);
+    ChunkBase *first = other.sentinel.next, *last = other.sentinel.prev;
+    first->prev = chunk->prev;
+    chunk->prev->next = first;
+    last->next = chunk;
+    chunk->prev = last;
+    size_ += other.size_;
+    other.sentinel.next = other.sentinel.prev = &other.sentinel;
+    other.size_ = 0;
+  }
+
+  void swap(unrolled_list &other) {
+    std::swap(sentinel.next, other.sentinel.next);
+    std::swap(sentinel.prev, other.sentinel.prev);
+    std::swap(size_, other.size_);
+    repairSentinel();
+    other.repairSentinel();
+  }
+
+  template <class... Args>
+  void emplace_back(Args &&...args) {
+    (push_back(std::forward<Args>(args)), ...);
+  }
+
+  template <class... Args>
+  void emplace_front(Args &&...args) {
+    (push_front(std::forward<Args>(args)), ...);
+  }
+
+ private:
+  // Moves item into the list in front of pos.
+  iterator place(iterator pos, value_type &item) {
+    ChunkBase *chunk = pos.chunk;
+    size_type index = pos.index;
+    if (index == 0 && chunk->prev != &sentinel &&
+        chunk->prev->count < chunkCapacity) {
+      chunk = chunk->prev;
+      index = chunk->count;
+    } else if (chunk == &sentinel) {
+      chunk = linkChunk(&sentinel);
+    } else if (chunk->count == chunkCapacity) {
+      auto half = chunkCapacity / 2;
+      auto right = splitChunk(chunk, half);
+      if (index > half) {
+        chunk = right;
+        index -= half;
+      }
+    }
+    T *items = data(chunk);
+    if (index == chunk->count) {
+      new (items + index) T(std::move(item));
+    } else {
+      new (items + chunk->count) T(std::move(items[chunk->count - 1]));
+      for (size_type i = chunk->count - 1; i > index; i--) {
+        items[i] = std::move(items[i - 1]);
+      }
+      items[index] = std::move(item);
+    }
+    chunk->count++;
+    size_++;
+    return iterator(chunk, index);
+  }
+
+  ChunkBase *linkChunk(ChunkBase *before) {
+    ChunkBase *chunk = new Chunk;
+    chunk->next = before;
+    chunk->prev = before->prev;
+    before->prev->next = chunk;
+    before->prev = chunk;
+    return chunk;
+  }
+
+  void unlinkChunk(ChunkBase *chunk) {
+    chunk->prev->next = chunk->next;
+    chunk->next->prev = chunk->prev;
+    delete static_cast<Chunk *>(chunk);
+  }
+
+  // Appends the elements of from starting at first to the end of to.
+  static void moveItems(ChunkBase *from, size_type first, ChunkBase *to) {
+    T *source = data(from), *target = data(to);
+    for (size_type i = first; i < from->count; i++) {
+      new (target + to->count++) T(std::move(source[i]));
+      source[i].~T();
+    }
+    from->count = first;
+  }
+
+  // Moves the elements from index on into a new chunk after chunk.
+  ChunkBase *splitChunk(ChunkBase *chunk, size_type index) {
+    ChunkBase *right = linkChunk(chunk->next);
+    moveItems(chunk, index, right);
+    return right;
+  }
+
+  void repairSentinel() {
+    if (size_ == 0) {
+      sentinel.next = sentinel.prev = &sentinel;
+    } else {
+      sentinel.next->prev = &sentinel;
+      sentinel.prev->next = &sentinel;
+    }
+  }
+
+  ChunkBase sentinel;
+  size_type size_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // _SRC_S21_UNROLLED_LIST_H_